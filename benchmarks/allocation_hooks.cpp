@@ -0,0 +1,5 @@
+// Allocation counting for the benchmark binary (ORDERBOOK_BENCH_ALLOCATIONS)
+#if ORDERBOOK_BENCH_ALLOCATIONS
+#define ORDERBOOK_ALLOCATION_HOOKS
+#include "utils/AllocationCounter.h"
+#endif
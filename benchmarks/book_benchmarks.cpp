@@ -0,0 +1,610 @@
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <random>
+#include <type_traits>
+#include <vector>
+#include "orderbook/BookProfiler.h"
+#include "orderbook/Orderbook.h"
+#include "orderbook/ReplayVerifier.h"
+#include "sim/OrderFlowGenerator.h"
+#include "utils/AllocationCounter.h"
+
+using namespace trading;
+
+// The order-flow scenarios take two arguments: the number of price levels resting
+// on each side and the spacing between adjacent levels in ticks. The feature
+// scenarios after them (icebergs, expiry, matching policies, auctions, mass
+// cancel, self-trade prevention, generated flow) size their own books. Times
+// are per message; items_per_second gives ops/s. Built with
+// ORDERBOOK_BENCH_ALLOCATIONS, the steady-state scenarios also report
+// allocs_per_op.
+
+namespace {
+
+constexpr int64_t MID = 10000000;           // 1000.0000
+constexpr int64_t TICK = 100;               // default tick size
+constexpr int ORDERS_PER_LEVEL = 4;
+constexpr int BATCH = 4096;
+
+const auto NOW = std::chrono::system_clock::now();
+
+Price bid_price(int level, int spread) { return Price::fromRaw(MID - (level + 1) * spread * TICK); }
+Price ask_price(int level, int spread) { return Price::fromRaw(MID + (level + 1) * spread * TICK); }
+
+Order make_order(int id, const Price& price, int volume, Side side) {
+    return Order("bench", price, id, volume, side, NOW);
+}
+
+// Rests `depth` levels per side with ORDERS_PER_LEVEL orders each, ids from 1.
+// Returns the next free id.
+int populate(Orderbook& book, int depth, int spread) {
+    std::vector<TradeInfo> trades;
+    int id = 1;
+    for (int level = 0; level < depth; ++level) {
+        for (int i = 0; i < ORDERS_PER_LEVEL; ++i) {
+            book.place_order(make_order(id++, bid_price(level, spread), 100, Side::BUY), trades);
+            book.place_order(make_order(id++, ask_price(level, spread), 100, Side::SELL), trades);
+        }
+    }
+    return id;
+}
+
+int depth_arg(const benchmark::State& state) { return static_cast<int>(state.range(0)); }
+int spread_arg(const benchmark::State& state) { return static_cast<int>(state.range(1)); }
+
+// Heap allocations per iteration since `scope` was opened, when counting is on
+void report_allocations(benchmark::State& state, const metrics::AllocationScope& scope) {
+    if (metrics::hooks_installed()) {
+        state.counters["allocs_per_op"] = benchmark::Counter(
+            static_cast<double>(scope.count()), benchmark::Counter::kAvgIterations);
+    }
+}
+
+void book_args(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"depth", "spread"});
+    b->ArgsProduct({{10, 100, 1000}, {1, 8}});
+}
+
+}
+
+// Passive inserts at random levels inside a deep book; each batch is cancelled
+// outside the timed region so depth stays constant
+static void BM_InsertDeepBook(benchmark::State& state) {
+    int depth = depth_arg(state), spread = spread_arg(state);
+    Orderbook book;
+    int next_id = populate(book, depth, spread);
+
+    std::mt19937 gen(1);
+    std::uniform_int_distribution<> level_dist(0, depth - 1);
+    std::vector<Order> batch;
+    batch.reserve(BATCH);
+    std::vector<TradeInfo> trades;
+    trades.reserve(BATCH);
+
+    size_t i = BATCH;
+    for (auto _ : state) {
+        if (i == BATCH) {
+            state.PauseTiming();
+            for (const Order& order : batch) {
+                book.cancel_order(order.get_order_id());
+            }
+            batch.clear();
+            for (int n = 0; n < BATCH; ++n) {
+                bool buy = n & 1;
+                int level = level_dist(gen);
+                batch.push_back(make_order(next_id++, buy ? bid_price(level, spread) : ask_price(level, spread),
+                                           100, buy ? Side::BUY : Side::SELL));
+            }
+            i = 0;
+            state.ResumeTiming();
+        }
+        benchmark::DoNotOptimize(book.place_order(batch[i++], trades));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_InsertDeepBook)->Apply(book_args);
+
+// Venue-like message mix: 92% cancels of resting orders each paired with a
+// fresh passive add, the rest marketable orders taking one lot off the touch
+static void BM_CancelHeavy(benchmark::State& state) {
+    int depth = depth_arg(state), spread = spread_arg(state);
+    Orderbook book;
+    int next_id = populate(book, depth, spread);
+
+    std::vector<int> live;
+    for (int id = 1; id < next_id; ++id) {
+        live.push_back(id);
+    }
+
+    std::mt19937 gen(2);
+    std::uniform_int_distribution<> action_dist(0, 99);
+    std::uniform_int_distribution<> level_dist(0, depth - 1);
+    std::vector<TradeInfo> trades;
+    trades.reserve(1 << 16);
+
+    metrics::AllocationScope allocations;
+    for (auto _ : state) {
+        bool buy = gen() & 1;
+        if (action_dist(gen) < 92) {
+            size_t pick = gen() % live.size();
+            book.cancel_order(live[pick]);
+
+            int level = level_dist(gen);
+            book.place_order(make_order(next_id, buy ? bid_price(level, spread) : ask_price(level, spread), 100,
+                                        buy ? Side::BUY : Side::SELL), trades);
+            live[pick] = next_id++;
+        } else {
+            book.place_order(make_order(next_id++, buy ? ask_price(0, spread) : bid_price(0, spread), 1,
+                                        buy ? Side::BUY : Side::SELL), trades);
+        }
+        if (trades.size() > (1 << 15)) {
+            trades.clear();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * 2);
+    report_allocations(state, allocations);
+}
+BENCHMARK(BM_CancelHeavy)->Apply(book_args);
+
+// One aggressive order sweeping every level of the ask side; the book is
+// rebuilt outside the timed region
+static void BM_AggressiveSweep(benchmark::State& state) {
+    int depth = depth_arg(state), spread = spread_arg(state);
+    Orderbook book;
+    std::vector<TradeInfo> trades;
+    trades.reserve(static_cast<size_t>(depth) * ORDERS_PER_LEVEL);
+
+    int next_id = 1;
+    int sweep_volume = depth * ORDERS_PER_LEVEL * 100;
+    for (auto _ : state) {
+        state.PauseTiming();
+        trades.clear();
+        for (int level = 0; level < depth; ++level) {
+            for (int i = 0; i < ORDERS_PER_LEVEL; ++i) {
+                book.place_order(make_order(next_id++, ask_price(level, spread), 100, Side::SELL), trades);
+            }
+        }
+        Order sweep = make_order(next_id++, ask_price(depth - 1, spread), sweep_volume, Side::BUY);
+        state.ResumeTiming();
+
+        benchmark::DoNotOptimize(book.place_order(sweep, trades));
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["levels_per_second"] = benchmark::Counter(
+        static_cast<double>(state.iterations()) * depth, benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_AggressiveSweep)->Apply(book_args);
+
+// Resting orders re-priced to random passive levels and re-sized
+static void BM_ModifyStorm(benchmark::State& state) {
+    int depth = depth_arg(state), spread = spread_arg(state);
+    Orderbook book;
+    int next_id = populate(book, depth, spread);
+
+    std::mt19937 gen(3);
+    std::uniform_int_distribution<> id_dist(1, next_id - 1);
+    std::uniform_int_distribution<> level_dist(0, depth - 1);
+    std::uniform_int_distribution<> volume_dist(50, 150);
+
+    metrics::AllocationScope allocations;
+    for (auto _ : state) {
+        int id = id_dist(gen);
+        // Odd ids are bids (see populate)
+        Price price = (id & 1) ? bid_price(level_dist(gen), spread) : ask_price(level_dist(gen), spread);
+        benchmark::DoNotOptimize(book.modify_order(id, price, volume_dist(gen)));
+    }
+    state.SetItemsProcessed(state.iterations());
+    report_allocations(state, allocations);
+}
+BENCHMARK(BM_ModifyStorm)->Apply(book_args);
+
+// Quotes added and pulled at the touch only, with a deep book behind them
+static void BM_TopOfBookChurn(benchmark::State& state) {
+    int depth = depth_arg(state), spread = spread_arg(state);
+    Orderbook book;
+    int next_id = populate(book, depth, spread);
+
+    // Alternate between joining the best level and improving it by a tick (when
+    // that leaves the book uncrossed)
+    int improve = spread > 1 ? 1 : 0;
+    Price bids[] = {bid_price(0, spread), Price::fromRaw(bid_price(0, spread).raw_value() + improve * TICK)};
+    Price asks[] = {ask_price(0, spread), Price::fromRaw(ask_price(0, spread).raw_value() - improve * TICK)};
+    std::vector<TradeInfo> trades;
+
+    uint64_t n = 0;
+    metrics::AllocationScope allocations;
+    for (auto _ : state) {
+        int k = static_cast<int>(n++ & 1);
+        int bid_id = next_id++;
+        int ask_id = next_id++;
+        book.place_order(make_order(bid_id, bids[k], 100, Side::BUY), trades);
+        book.place_order(make_order(ask_id, asks[k], 100, Side::SELL), trades);
+        book.cancel_order(bid_id);
+        book.cancel_order(ask_id);
+    }
+    state.SetItemsProcessed(state.iterations() * 4);
+    report_allocations(state, allocations);
+}
+BENCHMARK(BM_TopOfBookChurn)->Apply(book_args);
+
+// Full depth snapshot of both sides
+static void BM_DepthSnapshot(benchmark::State& state) {
+    int depth = depth_arg(state), spread = spread_arg(state);
+    Orderbook book;
+    populate(book, depth, spread);
+
+    for (auto _ : state) {
+        auto bids = book.get_bid_levels(depth);
+        auto asks = book.get_ask_levels(depth);
+        benchmark::DoNotOptimize(bids.data());
+        benchmark::DoNotOptimize(asks.data());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_DepthSnapshot)->Apply(book_args);
+
+// Takers against a queue of icebergs, each one exhausting a couple of peaks, so
+// most of the work is replenishing reserves in place and requeueing them
+static void BM_IcebergReplenish(benchmark::State& state) {
+    constexpr int ICEBERGS = 100;
+    constexpr int PEAK = 10;
+    Orderbook book;
+    std::vector<TradeInfo> trades;
+    trades.reserve(64);
+
+    int next_id = 1;
+    auto refill = [&] {
+        while (book.order_count() < ICEBERGS) {
+            Order iceberg = make_order(next_id++, ask_price(0, 1), 10000000, Side::SELL);
+            iceberg.set_peak_size(PEAK);
+            book.place_order(iceberg, trades);
+        }
+    };
+    refill();
+
+    for (auto _ : state) {
+        trades.clear();
+        book.place_order(make_order(next_id++, ask_price(0, 1), 25, Side::BUY), trades);
+        if (book.order_count() < ICEBERGS) {
+            state.PauseTiming();
+            refill();
+            state.ResumeTiming();
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_IcebergReplenish);
+
+// GTT orders with expiries spread over an hour, all expired by advancing the
+// clock a second at a time; the book is rebuilt outside the timed region
+static void BM_GttExpiry(benchmark::State& state) {
+    int orders = static_cast<int>(state.range(0));
+    Orderbook book;
+    std::vector<TradeInfo> trades;
+    std::mt19937 gen(11);
+    std::uniform_int_distribution<> level_dist(0, 999);
+    std::uniform_int_distribution<> expiry_dist(1, 3600 * 1000);
+
+    size_t expired = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        book = Orderbook();
+        book.advance_time(NOW);
+        for (int i = 0; i < orders; ++i) {
+            Order gtt = make_order(i + 1, bid_price(level_dist(gen), 1), 10, Side::BUY);
+            gtt.set_time_in_force(TimeInForce::GTT);
+            gtt.set_expire_time(NOW + std::chrono::milliseconds(expiry_dist(gen)));
+            book.place_order(gtt, trades);
+        }
+        state.ResumeTiming();
+
+        for (int second = 1; second <= 3600; ++second) {
+            expired += book.advance_time(NOW + std::chrono::seconds(second));
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(expired));
+}
+BENCHMARK(BM_GttExpiry)->ArgName("orders")->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond);
+
+// Deep single-level queues hit by takers, so the cost is dominated by how the
+// policy allocates each taker across the queue. One iteration is 50 makers and
+// 10 takers.
+template <typename Book>
+static void BM_MatchingPolicy(benchmark::State& state) {
+    Book book;
+    if constexpr (std::is_same_v<Book, FifoLmmOrderbook>) {
+        book.matching_policy().lmm_participant_id = 7;
+        book.matching_policy().lmm_percent = 40;
+    }
+    std::vector<TradeInfo> trades;
+    trades.reserve(1 << 10);
+    std::mt19937 gen(17);
+    std::uniform_int_distribution<> volume_dist(1, 100);
+    std::uniform_int_distribution<> participant_dist(1, 20);
+
+    int next_id = 1;
+    for (auto _ : state) {
+        for (int i = 0; i < 50; ++i) {
+            Order maker = make_order(next_id++, ask_price(0, 1), volume_dist(gen), Side::SELL);
+            maker.set_participant_id(participant_dist(gen));
+            book.place_order(maker, trades);
+        }
+        for (int i = 0; i < 10; ++i) {
+            trades.clear();
+            book.place_order(make_order(next_id++, ask_price(0, 1), 250, Side::BUY), trades);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * 60);
+}
+BENCHMARK_TEMPLATE(BM_MatchingPolicy, Orderbook);
+BENCHMARK_TEMPLATE(BM_MatchingPolicy, ProRataOrderbook);
+BENCHMARK_TEMPLATE(BM_MatchingPolicy, FifoLmmOrderbook);
+
+// Auction book where the top half of the asks and the bottom half of the bids
+// overlap, so every level on both sides is an uncross candidate
+void populate_auction(Orderbook& book, int levels) {
+    std::vector<TradeInfo> trades;
+    book.begin_auction();
+    for (int i = 0; i < levels; ++i) {
+        book.place_order(make_order(2 * i + 1, Price::fromRaw(MID + i * TICK), 10, Side::BUY), trades);
+        book.place_order(make_order(2 * i + 2, Price::fromRaw(MID + (i - levels / 2) * TICK), 10, Side::SELL),
+                         trades);
+    }
+}
+
+static void BM_IndicativeUncross(benchmark::State& state) {
+    Orderbook book;
+    populate_auction(book, static_cast<int>(state.range(0)));
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(book.indicative_uncross());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_IndicativeUncross)->ArgName("levels")->Arg(1000)->Arg(20000);
+
+// Uncross and execution; the auction book is rebuilt outside the timed region
+static void BM_AuctionUncross(benchmark::State& state) {
+    int levels = static_cast<int>(state.range(0));
+    Orderbook book;
+    std::vector<TradeInfo> trades;
+    trades.reserve(static_cast<size_t>(levels));
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        book = Orderbook();
+        populate_auction(book, levels);
+        trades.clear();
+        state.ResumeTiming();
+
+        benchmark::DoNotOptimize(book.uncross(trades));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_AuctionUncross)->ArgName("levels")->Arg(1000)->Arg(20000);
+
+namespace {
+
+constexpr int PARTICIPANTS = 1000;
+
+// `orders` resting orders over 5000 levels per side, with participants dealt
+// round-robin by id: participant p owns ids p, p + PARTICIPANTS, ...
+void populate_participants(Orderbook& book, int orders) {
+    std::vector<TradeInfo> trades;
+    std::mt19937 gen(23);
+    std::uniform_int_distribution<> level_dist(0, 4999);
+    for (int i = 0; i < orders; ++i) {
+        Side side = (i % 2 == 0) ? Side::BUY : Side::SELL;
+        int level = level_dist(gen);
+        Order order = make_order(i + 1, side == Side::BUY ? bid_price(level, 1) : ask_price(level, 1), 10, side);
+        order.set_participant_id(i % PARTICIPANTS + 1);
+        book.place_order(order, trades);
+    }
+}
+
+}
+
+// Kill switch: every order of one participant through the intrusive
+// per-participant list
+static void BM_MassCancel(benchmark::State& state) {
+    int orders = static_cast<int>(state.range(0));
+    Orderbook book;
+    populate_participants(book, orders);
+
+    int participant = 1;
+    size_t cancelled = 0;
+    for (auto _ : state) {
+        if (participant > PARTICIPANTS) {
+            state.PauseTiming();
+            book = Orderbook();
+            populate_participants(book, orders);
+            participant = 1;
+            state.ResumeTiming();
+        }
+        cancelled += book.mass_cancel(participant++);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(cancelled));
+}
+BENCHMARK(BM_MassCancel)->ArgName("orders")->Arg(100000)->Arg(1000000);
+
+// Baseline for BM_MassCancel: the same orders pulled one cancel_order at a time
+static void BM_CancelParticipantById(benchmark::State& state) {
+    int orders = static_cast<int>(state.range(0));
+    Orderbook book;
+    populate_participants(book, orders);
+
+    int participant = 1;
+    int64_t cancelled = 0;
+    for (auto _ : state) {
+        if (participant > PARTICIPANTS) {
+            state.PauseTiming();
+            book = Orderbook();
+            populate_participants(book, orders);
+            participant = 1;
+            state.ResumeTiming();
+        }
+        for (int id = participant; id <= orders; id += PARTICIPANTS) {
+            book.cancel_order(id);
+            cancelled++;
+        }
+        participant++;
+    }
+    state.SetItemsProcessed(cancelled);
+}
+BENCHMARK(BM_CancelParticipantById)->ArgName("orders")->Arg(100000)->Arg(1000000);
+
+// Random crossing flow with self-trade prevention off (0) and on (1);
+// participants are distinct per client, so the check runs on every fill but
+// rarely fires
+static void BM_SelfTradePrevention(benchmark::State& state) {
+    Orderbook book;
+    book.set_self_trade_prevention(state.range(0) ? SelfTradePrevention::CANCEL_OLDEST : SelfTradePrevention::NONE);
+    std::vector<TradeInfo> trades;
+    trades.reserve(1 << 16);
+    std::mt19937 gen(5);
+    std::uniform_int_distribution<> offset_dist(-100, 100);
+    std::uniform_int_distribution<> volume_dist(10, 500);
+
+    int next_id = 1;
+    for (auto _ : state) {
+        Side side = (gen() & 1) ? Side::BUY : Side::SELL;
+        Order order = make_order(next_id, Price::fromRaw(MID + offset_dist(gen) * TICK), volume_dist(gen), side);
+        order.set_participant_id(next_id++ % 11 + 1);
+        book.place_order(order, trades);
+        if (trades.size() > (1 << 15)) {
+            trades.clear();
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SelfTradePrevention)->ArgName("stp")->Arg(0)->Arg(1);
+
+// Mixed flow of 70% adds, 20% cancels and 10% amends around the mid. Built with
+// ORDERBOOK_LATENCY_STATS it also reports the book's own per-operation tail
+// latencies in nanoseconds.
+static void BM_MixedFlow(benchmark::State& state) {
+    Orderbook book;
+    std::vector<TradeInfo> trades;
+    trades.reserve(1 << 16);
+    std::mt19937 gen(6);
+    std::uniform_int_distribution<> action_dist(0, 9);
+    std::uniform_int_distribution<> offset_dist(-100, 100);
+    std::uniform_int_distribution<> volume_dist(10, 500);
+
+    std::vector<int> live;
+    int next_id = 1;
+    for (auto _ : state) {
+        int action = action_dist(gen);
+        if (action < 2 && !live.empty()) {
+            size_t pick = gen() % live.size();
+            book.cancel_order(live[pick]);
+            live[pick] = live.back();
+            live.pop_back();
+        } else if (action < 3 && !live.empty()) {
+            book.modify_order(live[gen() % live.size()], Price::fromRaw(MID + offset_dist(gen) * TICK),
+                              volume_dist(gen));
+        } else {
+            Side side = (gen() & 1) ? Side::BUY : Side::SELL;
+            book.place_order(make_order(next_id, Price::fromRaw(MID + offset_dist(gen) * TICK), volume_dist(gen),
+                                        side), trades);
+            live.push_back(next_id++);
+        }
+        if (trades.size() > (1 << 15)) {
+            trades.clear();
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+
+#if ORDERBOOK_LATENCY_STATS
+    const char* names[] = {"place", "cancel", "modify", "match"};
+    for (int op = 0; op < static_cast<int>(BookOperation::COUNT); ++op) {
+        metrics::LatencySummary summary = book.latency_summary(static_cast<BookOperation>(op));
+        state.counters[std::string(names[op]) + "_p50"] = static_cast<double>(summary.p50);
+        state.counters[std::string(names[op]) + "_p99"] = static_cast<double>(summary.p99);
+        state.counters[std::string(names[op]) + "_p99.9"] = static_cast<double>(summary.p999);
+    }
+#endif
+}
+BENCHMARK(BM_MixedFlow);
+
+namespace {
+
+BookOperation operation_of(const io::EventRecord& record) {
+    return record.type == io::EventType::ORDER_PLACED ? BookOperation::PLACE
+         : record.type == io::EventType::ORDER_CANCELLED ? BookOperation::CANCEL
+         : BookOperation::MODIFY;
+}
+
+}
+
+// Synthetic flow from the order-flow generator, applied batch by batch; the
+// batches are generated outside the timed region
+static void BM_GeneratedFlow(benchmark::State& state) {
+    sim::OrderFlowConfig config;
+    config.seed = 42;
+    config.buffer_capacity = 1000;
+    sim::OrderFlowGenerator generator(config);
+    Orderbook book;
+    std::vector<TradeInfo> trades;
+    trades.reserve(1 << 16);
+
+    int64_t applied = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        size_t n = generator.next_batch(book, config.buffer_capacity);
+        trades.clear();
+        state.ResumeTiming();
+
+        for (size_t i = 0; i < n; ++i) {
+            ReplayVerifier::apply(book, generator[i], trades);
+        }
+        applied += static_cast<int64_t>(n);
+    }
+    state.SetItemsProcessed(applied);
+}
+BENCHMARK(BM_GeneratedFlow);
+
+// Hardware counter attribution of the generated flow: cycles and instructions
+// per call by operation. Each call pays two read() syscalls, so the timings of
+// this case are not comparable with the others; without perf access it only
+// runs the flow.
+static void BM_GeneratedFlowCounters(benchmark::State& state) {
+    sim::OrderFlowConfig config;
+    config.seed = 8;
+    config.buffer_capacity = 4096;
+    sim::OrderFlowGenerator generator(config);
+    Orderbook book;
+    BookProfiler profiler;
+    std::vector<TradeInfo> trades;
+    trades.reserve(4096);
+
+    int64_t applied = 0;
+    for (auto _ : state) {
+        size_t n = generator.next_batch(book, config.buffer_capacity);
+        for (size_t i = 0; i < n; ++i) {
+            const io::EventRecord& record = generator[i];
+            trades.clear();
+            profiler.measure(operation_of(record), [&] { ReplayVerifier::apply(book, record, trades); });
+        }
+        applied += static_cast<int64_t>(n);
+    }
+    state.SetItemsProcessed(applied);
+
+    if (!profiler.available()) {
+        state.SetLabel("no perf counters");
+        return;
+    }
+    const char* names[] = {"place", "cancel", "modify"};
+    for (int op = 0; op < 3; ++op) {
+        const BookProfiler::Totals& totals = profiler.totals(static_cast<BookOperation>(op));
+        if (totals.calls == 0) {
+            continue;
+        }
+        double calls = static_cast<double>(totals.calls);
+        state.counters[std::string(names[op]) + "_cycles"] =
+            totals.events[static_cast<size_t>(metrics::PerfEvent::CYCLES)] / calls;
+        state.counters[std::string(names[op]) + "_instructions"] =
+            totals.events[static_cast<size_t>(metrics::PerfEvent::INSTRUCTIONS)] / calls;
+    }
+}
+BENCHMARK(BM_GeneratedFlowCounters);
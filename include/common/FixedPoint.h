@@ -1,58 +1,150 @@
 #pragma once
 #include <cstdint>
+#include <functional>
 #include <iostream>
+#include <stdexcept>
 #include <string>
 
-class Price {
+namespace fixed_point {
+
+constexpr int decimals_of(int64_t scale) {
+    int digits = 0;
+    while (scale > 1) {
+        scale /= 10;
+        digits++;
+    }
+    return digits;
+}
+
+constexpr bool is_power_of_ten(int64_t scale) {
+    while (scale > 1 && scale % 10 == 0) {
+        scale /= 10;
+    }
+    return scale == 1;
+}
+
+}
+
+// Fixed-point price stored as an integer count of 1/Scale units. Arithmetic
+// and comparisons are constexpr and inline, so ordering prices is a plain
+// integer compare; only string parsing and formatting are heavier.
+template <int64_t Scale>
+class BasicPrice {
 private:
     int64_t value_; // Internal representation (price * SCALE)
-    static constexpr int64_t SCALE = 10000; // 4 decimal places of precision
-    
+
 public:
+    static_assert(Scale > 0 && fixed_point::is_power_of_ten(Scale), "scale must be a power of ten");
+    static constexpr int64_t SCALE = Scale;
+    static constexpr int DECIMALS = fixed_point::decimals_of(Scale);
+
     // Constructors
-    Price();
-    
-    // From double - use carefully
-    explicit Price(double price);
-    
+    constexpr BasicPrice() : value_(0) {}
+
+    // From double - rounds to the nearest unit, so 1.13 is 1.1300 rather than
+    // the 1.1299 the binary value truncates to
+    constexpr explicit BasicPrice(double price)
+        : value_(static_cast<int64_t>(price * SCALE + (price < 0 ? -0.5 : 0.5))) {}
+
     // From int64_t raw value
-    static Price fromRaw(int64_t raw);   
+    static constexpr BasicPrice fromRaw(int64_t raw) {
+        BasicPrice p;
+        p.value_ = raw;
+        return p;
+    }
 
-	// From string (safer than double for exact representation)
-	explicit Price(const std::string& price_str);   
+	// From string (safer than double for exact representation); digits past
+	// DECIMALS are truncated
+	explicit BasicPrice(const std::string& price_str);
 
     // Accessors
-    int64_t raw_value() const;
-    
+    constexpr int64_t raw_value() const { return value_; }
+
     // Convert to double (for display/external use only)
-    double to_double() const;
-    
+    constexpr double to_double() const { return static_cast<double>(value_) / SCALE; }
+
     // Convert to string with proper decimal places
-    std::string to_string() const;    
+    std::string to_string() const;
 
-    // Arithmetic operators
-	Price operator+(const Price& other) const;    
-    Price operator-(const Price& other) const;    
-    Price operator*(int mult) const;    
-    Price operator/(int div) const;    
+    // Arithmetic operators; addition throws std::overflow_error on overflow
+	constexpr BasicPrice operator+(const BasicPrice& other) const {
+        int64_t result = 0;
+        if (__builtin_add_overflow(value_, other.value_, &result)) {
+            throw std::overflow_error("Price addition overflow");
+        }
+        return fromRaw(result);
+    }
+    constexpr BasicPrice operator-(const BasicPrice& other) const { return fromRaw(value_ - other.value_); }
+    constexpr BasicPrice operator*(int mult) const { return fromRaw(value_ * mult); }
+    constexpr BasicPrice operator/(int div) const { return fromRaw(value_ / div); }
 
     // Comparison operators
-    bool operator==(const Price& other) const;
-    bool operator!=(const Price& other) const;
-    bool operator<(const Price& other) const;
-    bool operator<=(const Price& other) const;
-    bool operator>(const Price& other) const;
-    bool operator>=(const Price& other) const;
+    constexpr bool operator==(const BasicPrice& other) const { return value_ == other.value_; }
+    constexpr bool operator!=(const BasicPrice& other) const { return value_ != other.value_; }
+    constexpr bool operator<(const BasicPrice& other) const { return value_ < other.value_; }
+    constexpr bool operator<=(const BasicPrice& other) const { return value_ <= other.value_; }
+    constexpr bool operator>(const BasicPrice& other) const { return value_ > other.value_; }
+    constexpr bool operator>=(const BasicPrice& other) const { return value_ >= other.value_; }
 };
 
-inline std::ostream& operator<<(std::ostream& os, const Price& price) {
+// 4 decimal places of precision
+using Price = BasicPrice<10000>;
+
+template <int64_t Scale>
+BasicPrice<Scale>::BasicPrice(const std::string& price_str) {
+    // Find decimal point
+    size_t decimal_pos = price_str.find('.');
+
+    if (decimal_pos == std::string::npos) {
+        // No decimal point, just whole number
+        value_ = std::stoll(price_str) * SCALE;
+        return;
+    }
+
+    // Has decimal point - handle whole part and decimal part separately
+    std::string whole_part = price_str.substr(0, decimal_pos);
+    int64_t whole_value = whole_part.empty() ? 0 : std::stoll(whole_part);
+
+    // Extract decimal part and pad/truncate to DECIMALS digits
+    std::string decimal_part = price_str.substr(decimal_pos + 1);
+    decimal_part.resize(DECIMALS, '0');
+    int64_t decimal_value = decimal_part.empty() ? 0 : std::stoll(decimal_part);
+
+    // Combine whole and decimal parts; the sign of "-0.5" is only in the text
+    bool negative = !price_str.empty() && price_str[0] == '-';
+    value_ = whole_value * SCALE + (negative ? -decimal_value : decimal_value);
+}
+
+template <int64_t Scale>
+std::string BasicPrice<Scale>::to_string() const {
+    int64_t whole_part = value_ / SCALE;
+    int64_t decimal_part = value_ % SCALE;
+
+    std::string result = value_ < 0 && whole_part == 0 ? "-0" : std::to_string(whole_part);
+    if (DECIMALS == 0) {
+        return result;
+    }
+    result += ".";
+
+    // Format decimal part with leading zeros
+    std::string decimal_str = std::to_string(decimal_part < 0 ? -decimal_part : decimal_part);
+    result.append(DECIMALS - decimal_str.length(), '0');
+    result += decimal_str;
+
+    return result;
+}
+
+template <int64_t Scale>
+inline std::ostream& operator<<(std::ostream& os, const BasicPrice<Scale>& price) {
     os << price.to_string();
     return os;
 }
 
 namespace std {
-    template<>
-    struct hash<Price> {
-        size_t operator()(const Price& p) const;    
+    template<int64_t Scale>
+    struct hash<BasicPrice<Scale>> {
+        size_t operator()(const BasicPrice<Scale>& p) const {
+            return hash<int64_t>()(p.raw_value());
+        }
     };
 }
@@ -0,0 +1,56 @@
+#pragma once
+#include <cstddef>
+#include <cstring>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+namespace trading {
+
+// Short string stored inline, for identifiers copied on the hot path (client
+// names on orders and trades). Longer input is truncated to Capacity bytes.
+template <size_t Capacity>
+class FixedString {
+public:
+    static_assert(Capacity < 256, "length is stored in one byte");
+
+    FixedString() = default;
+    FixedString(const char* s) { assign(s, std::strlen(s)); }
+    FixedString(const std::string& s) { assign(s.data(), s.size()); }
+    FixedString(std::string_view s) { assign(s.data(), s.size()); }
+
+    const char* data() const { return data_; }
+    const char* c_str() const { return data_; }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    static constexpr size_t capacity() { return Capacity; }
+
+    std::string_view view() const { return std::string_view(data_, size_); }
+    std::string str() const { return std::string(data_, size_); }
+
+    friend bool operator==(const FixedString& a, const FixedString& b) { return a.view() == b.view(); }
+    friend bool operator==(const FixedString& a, const char* b) { return a.view() == b; }
+    friend bool operator==(const FixedString& a, const std::string& b) { return a.view() == b; }
+    friend bool operator==(const char* a, const FixedString& b) { return b == a; }
+    friend bool operator==(const std::string& a, const FixedString& b) { return b == a; }
+    friend bool operator!=(const FixedString& a, const FixedString& b) { return !(a == b); }
+    friend bool operator!=(const FixedString& a, const char* b) { return !(a == b); }
+    friend bool operator!=(const FixedString& a, const std::string& b) { return !(a == b); }
+
+    friend std::ostream& operator<<(std::ostream& os, const FixedString& s) { return os << s.view(); }
+
+private:
+    char data_[Capacity + 1] = {};
+    unsigned char size_ = 0;
+
+    void assign(const char* s, size_t length) {
+        size_ = static_cast<unsigned char>(length < Capacity ? length : Capacity);
+        std::memcpy(data_, s, size_);
+        data_[size_] = '\0';
+    }
+};
+
+// Client names on orders and trades; the journal keeps the first 16 bytes
+using ClientName = FixedString<22>;
+
+}
@@ -0,0 +1,210 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace trading {
+
+// Open-addressing hash map with linear probing and backward-shift deletion.
+//
+// Entries live in one flat array, so insert only allocates when the table
+// grows past half full and erase never does: once a map has seen its peak
+// size, lookups and updates stay off the heap. Insert and erase invalidate
+// iterators. Key and Value must be default constructible.
+//
+// A default constructed or moved-from map owns no table until the first
+// insert, so construction and moves never allocate.
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class FlatHashMap {
+public:
+    using value_type = std::pair<Key, Value>;
+    using iterator = value_type*;
+    using const_iterator = const value_type*;
+
+    static constexpr size_t MIN_CAPACITY = 16;
+
+    FlatHashMap() = default;
+
+    // Moved-from maps are left empty but usable
+    FlatHashMap(const FlatHashMap&) = default;
+    FlatHashMap(FlatHashMap&& other) noexcept { swap(other); }
+    FlatHashMap& operator=(const FlatHashMap&) = default;
+    FlatHashMap& operator=(FlatHashMap&& other) noexcept {
+        FlatHashMap moved(std::move(other));
+        swap(moved);
+        return *this;
+    }
+
+    void swap(FlatHashMap& other) noexcept {
+        slots_.swap(other.slots_);
+        used_.swap(other.used_);
+        std::swap(size_, other.size_);
+        std::swap(mask_, other.mask_);
+        std::swap(shift_, other.shift_);
+    }
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    size_t capacity() const { return slots_.size(); }
+
+    iterator end() { return nullptr; }
+    const_iterator end() const { return nullptr; }
+
+    iterator find(const Key& key) {
+        if (slots_.empty()) {
+            return nullptr;
+        }
+        size_t i = probe(key);
+        return used_[i] ? &slots_[i] : nullptr;
+    }
+    const_iterator find(const Key& key) const {
+        if (slots_.empty()) {
+            return nullptr;
+        }
+        size_t i = probe(key);
+        return used_[i] ? &slots_[i] : nullptr;
+    }
+
+    Value& operator[](const Key& key) {
+        if (slots_.empty()) {
+            resize(MIN_CAPACITY);
+        }
+        size_t i = probe(key);
+        if (!used_[i]) {
+            if ((size_ + 1) * 2 > slots_.size()) {
+                resize(slots_.size() * 2);
+                i = probe(key);
+            }
+            used_[i] = 1;
+            slots_[i] = value_type(key, Value());
+            size_++;
+        }
+        return slots_[i].second;
+    }
+
+    size_t erase(const Key& key) {
+        if (slots_.empty()) {
+            return 0;
+        }
+        size_t i = probe(key);
+        if (!used_[i]) {
+            return 0;
+        }
+        erase_slot(i);
+        return 1;
+    }
+    void erase(iterator it) { erase_slot(static_cast<size_t>(it - slots_.data())); }
+
+    void clear() {
+        std::fill(used_.begin(), used_.end(), 0);
+        size_ = 0;
+    }
+
+    // Sizes the table for n entries without further growth
+    void reserve(size_t n) {
+        size_t capacity = table_size_for(n);
+        if (capacity > slots_.size()) {
+            resize(capacity);
+        }
+    }
+
+    // Grows or shrinks to the table size for max(n, size()); rehash(0) shrinks to
+    // fit, releasing the table of an empty map
+    void rehash(size_t n) {
+        if (n == 0 && size_ == 0) {
+            std::vector<value_type>().swap(slots_);
+            std::vector<uint8_t>().swap(used_);
+            mask_ = 0;
+            shift_ = 0;
+            return;
+        }
+        size_t capacity = table_size_for(n > size_ ? n : size_);
+        if (capacity != slots_.size()) {
+            resize(capacity);
+        }
+    }
+
+    template <typename Fn>
+    void for_each(Fn&& fn) const {
+        for (size_t i = 0; i < slots_.size(); ++i) {
+            if (used_[i]) {
+                fn(slots_[i].first, slots_[i].second);
+            }
+        }
+    }
+
+private:
+    std::vector<value_type> slots_;
+    std::vector<uint8_t> used_;
+    size_t size_ = 0;
+    size_t mask_ = 0;
+    int shift_ = 0;
+
+    static size_t table_size_for(size_t n) {
+        size_t capacity = MIN_CAPACITY;
+        while (capacity < n * 2) {
+            capacity <<= 1;
+        }
+        return capacity;
+    }
+
+    // Fibonacci hashing: spreads sequential keys such as order ids and ticks
+    size_t home(const Key& key) const {
+        uint64_t h = static_cast<uint64_t>(Hash()(key)) * 0x9E3779B97F4A7C15ULL;
+        return static_cast<size_t>(h >> shift_);
+    }
+
+    // Slot holding key, or the empty slot where it would go
+    size_t probe(const Key& key) const {
+        size_t i = home(key);
+        while (used_[i] && !(slots_[i].first == key)) {
+            i = (i + 1) & mask_;
+        }
+        return i;
+    }
+
+    void erase_slot(size_t hole) {
+        // Pull back later entries of the cluster whose home is not after the hole
+        size_t j = hole;
+        while (true) {
+            j = (j + 1) & mask_;
+            if (!used_[j]) {
+                break;
+            }
+            size_t k = home(slots_[j].first);
+            bool stays = hole <= j ? (hole < k && k <= j) : (hole < k || k <= j);
+            if (!stays) {
+                slots_[hole] = std::move(slots_[j]);
+                hole = j;
+            }
+        }
+        used_[hole] = 0;
+        size_--;
+    }
+
+    void resize(size_t capacity) {
+        std::vector<value_type> old_slots(capacity);
+        std::vector<uint8_t> old_used(capacity, 0);
+        old_slots.swap(slots_);
+        old_used.swap(used_);
+        mask_ = capacity - 1;
+        shift_ = 64;
+        for (size_t c = capacity; c > 1; c >>= 1) {
+            shift_--;
+        }
+        size_ = 0;
+        for (size_t i = 0; i < old_slots.size(); ++i) {
+            if (old_used[i]) {
+                size_t slot = probe(old_slots[i].first);
+                used_[slot] = 1;
+                slots_[slot] = std::move(old_slots[i]);
+                size_++;
+            }
+        }
+    }
+};
+
+}
@@ -1,8 +1,12 @@
 #pragma once
+#include <algorithm>
 #include <array>
 #include <cassert>
 #include <vector>
 #include <cstddef>
+#include <cstdint>
+#include <memory>
+#include "../utils/FlightRecorder.h"
 
 namespace trading {
 namespace memory {
@@ -97,11 +101,62 @@ public:
     }
 };
 
-// Expandable memory pool with multiple blocks
+// Blocks by fill: bucket i counts non-empty blocks with used/capacity in
+// (i/N, (i+1)/N], so the last bucket is full blocks
+constexpr size_t OCCUPANCY_BUCKETS = 8;
+
+// Snapshot of a pool. Counters are cumulative; rates come from diffing two
+// snapshots taken a known interval apart.
+struct PoolStats {
+    size_t blocks = 0;
+    size_t empty_blocks = 0;
+    size_t capacity = 0;            // objects
+    size_t used = 0;
+    size_t high_water = 0;          // peak of used since construction
+    size_t block_bytes = 0;         // footprint of one block
+    uint64_t allocations = 0;
+    uint64_t deallocations = 0;
+    uint64_t blocks_allocated = 0;
+    uint64_t blocks_released = 0;
+    std::array<size_t, OCCUPANCY_BUCKETS> occupancy{};
+
+    size_t bytes() const { return blocks * block_bytes; }
+
+    // Share of free slots in blocks that cannot be released because they hold
+    // at least one object
+    double fragmentation() const {
+        size_t pinned = (blocks - empty_blocks) * (blocks ? capacity / blocks : 0);
+        return pinned ? 1.0 - static_cast<double>(used) / static_cast<double>(pinned) : 0.0;
+    }
+
+    double allocation_rate(const PoolStats& earlier, double seconds) const {
+        return seconds > 0.0 ? static_cast<double>(allocations - earlier.allocations) / seconds : 0.0;
+    }
+    double free_rate(const PoolStats& earlier, double seconds) const {
+        return seconds > 0.0 ? static_cast<double>(deallocations - earlier.deallocations) / seconds : 0.0;
+    }
+};
+
+// Expandable memory pool with multiple blocks. Blocks are separate heap
+// allocations, so objects never move; trim() hands back the empty ones.
 template <typename T, size_t BlockSize = 1024>
 class MemoryPool {
 private:
     std::vector<std::unique_ptr<MemoryBlock<T>>> blocks_;
+    size_t used_ = 0;
+    size_t high_water_ = 0;
+    uint64_t allocations_ = 0;
+    uint64_t deallocations_ = 0;
+    uint64_t blocks_allocated_ = 1;
+    uint64_t blocks_released_ = 0;
+
+    T* allocated(T* obj) {
+        allocations_++;
+        if (++used_ > high_water_) {
+            high_water_ = used_;
+        }
+        return obj;
+    }
 
 public:
     MemoryPool() {
@@ -115,21 +170,28 @@ public:
         // try to allocate from existing blocks
         for (auto& block : blocks_) {
             T* obj = block->allocate();
-            if (obj != nullptr) return obj;
+            if (obj != nullptr) return allocated(obj);
         }
 
         // all blocks full, create a new one
         blocks_.push_back(
             std::make_unique<FixedMemoryBlock<T, BlockSize>>()
         );
+        blocks_allocated_++;
+        ORDERBOOK_TRACE(POOL_GROW, 0, 0, static_cast<int>(BlockSize), static_cast<int>(blocks_.size()), 0);
 
-        return blocks_.back()->allocate();
+        return allocated(blocks_.back()->allocate());
     }
 
     void deallocate(T* obj) {
         for (auto& block : blocks_) {
             if (block->owns(obj)) {
+                size_t before = block->used();
                 block->deallocate(obj);
+                if (block->used() < before) {
+                    used_--;
+                    deallocations_++;
+                }
                 return;
             }
         }
@@ -137,20 +199,65 @@ public:
         assert(false && "tried to deallocate object not owned by this pool");
     }
 
-    size_t total_capacity() const {
-        size_t total = 0;
-        for (const auto& block : blocks_) {
-            total += block->capacity();
+    // Releases empty blocks, keeping `spare` of them (and always one block) so
+    // a pool oscillating around a block boundary does not churn the heap.
+    // Live objects are untouched. Returns the number of blocks released.
+    size_t trim(size_t spare = 0) {
+        // Compact in place so the surviving blocks keep their order; allocation
+        // fills from the front
+        size_t kept = 0;
+        size_t kept_empty = 0;
+        for (auto& block : blocks_) {
+            bool empty = block->used() == 0;
+            if (empty && kept_empty >= spare) {
+                continue;
+            }
+            kept_empty += empty;
+            blocks_[kept++] = std::move(block);
         }
-        return total;
+        if (kept == 0 && !blocks_.empty()) {
+            kept = 1;
+        }
+
+        size_t released = blocks_.size() - kept;
+        blocks_.resize(kept);
+        blocks_released_ += released;
+        return released;
     }
 
-    size_t total_used() const {
-        size_t total = 0;
+    PoolStats stats() const {
+        PoolStats stats;
+        stats.blocks = blocks_.size();
+        stats.used = used_;
+        stats.high_water = high_water_;
+        stats.block_bytes = sizeof(FixedMemoryBlock<T, BlockSize>);
+        stats.allocations = allocations_;
+        stats.deallocations = deallocations_;
+        stats.blocks_allocated = blocks_allocated_;
+        stats.blocks_released = blocks_released_;
         for (const auto& block : blocks_) {
-            total += block->used();
+            stats.capacity += block->capacity();
+            size_t used = block->used();
+            if (used == 0) {
+                stats.empty_blocks++;
+            } else {
+                size_t bucket = (used * OCCUPANCY_BUCKETS - 1) / block->capacity();
+                stats.occupancy[std::min(bucket, OCCUPANCY_BUCKETS - 1)]++;
+            }
         }
-        return total;
+        return stats;
+    }
+
+    size_t block_count() const {
+        return blocks_.size();
+    }
+
+    size_t total_capacity() const {
+        return blocks_.size() * BlockSize;
+    }
+
+    size_t total_used() const {
+        return used_;
     }
 };
 
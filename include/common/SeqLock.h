@@ -0,0 +1,62 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include "SpscRing.h"
+
+namespace trading {
+namespace concurrency {
+
+// Single-writer sequence lock for publishing small snapshots (book signals,
+// top of book) to any number of readers without blocking the writer.
+//
+// The writer bumps the sequence to odd, copies the value and bumps it to even;
+// readers retry while the sequence is odd or changed during their copy. Stores
+// never wait, so this is safe to call from the matching thread.
+template <typename T>
+class SeqLock {
+    static_assert(std::is_trivially_copyable<T>::value, "SeqLock values are copied with memcpy");
+
+private:
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> sequence_{0};
+    T value_{};
+
+public:
+    SeqLock() = default;
+    SeqLock(const SeqLock&) = delete;
+    SeqLock& operator=(const SeqLock&) = delete;
+
+    // Writer side - one thread only
+    void store(const T& value) {
+        uint64_t seq = sequence_.load(std::memory_order_relaxed);
+        sequence_.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        std::memcpy(static_cast<void*>(&value_), &value, sizeof(T));
+        sequence_.store(seq + 2, std::memory_order_release);
+    }
+
+    // Reader side: one attempt, false if a store was in progress
+    bool try_load(T& out) const {
+        uint64_t before = sequence_.load(std::memory_order_acquire);
+        if (before & 1) {
+            return false;
+        }
+        std::memcpy(static_cast<void*>(&out), &value_, sizeof(T));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return sequence_.load(std::memory_order_relaxed) == before;
+    }
+
+    T load() const {
+        T out;
+        while (!try_load(out)) {
+        }
+        return out;
+    }
+
+    // Number of completed stores
+    uint64_t version() const { return sequence_.load(std::memory_order_acquire) / 2; }
+};
+
+}
+}
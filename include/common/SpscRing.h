@@ -0,0 +1,101 @@
+#pragma once
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+
+namespace trading {
+namespace concurrency {
+
+constexpr size_t CACHE_LINE_SIZE = 64;
+
+// Bounded single-producer/single-consumer ring buffer.
+// Storage is allocated once up front; push and pop never allocate and never
+// enter the kernel, so the producer side is safe to call from the matching thread.
+template <typename T>
+class SpscRing {
+private:
+    const size_t capacity_;
+    const size_t mask_;
+    std::unique_ptr<T[]> slots_;
+
+    // Producer-owned cache line
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> tail_{0};
+    size_t cached_head_ = 0;
+
+    // Consumer-owned cache line
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> head_{0};
+    size_t cached_tail_ = 0;
+
+    static size_t round_up_pow2(size_t n) {
+        size_t p = 1;
+        while (p < n) p <<= 1;
+        return p;
+    }
+
+public:
+    explicit SpscRing(size_t capacity) :
+        capacity_(round_up_pow2(capacity < 2 ? 2 : capacity)),
+        mask_(capacity_ - 1),
+        slots_(new T[capacity_])
+    {}
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    // Producer side
+    bool try_push(const T& item) {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - cached_head_ >= capacity_) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            if (tail - cached_head_ >= capacity_) return false;
+        }
+
+        slots_[tail & mask_] = item;
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side
+    bool try_pop(T& item) {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        if (head == cached_tail_) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            if (head == cached_tail_) return false;
+        }
+
+        item = slots_[head & mask_];
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Pops up to max_items into out, publishing the new head once for the whole batch
+    size_t pop_batch(T* out, size_t max_items) {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        if (head == cached_tail_) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+        }
+
+        size_t available = cached_tail_ - head;
+        size_t count = available < max_items ? available : max_items;
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = slots_[(head + i) & mask_];
+        }
+
+        if (count > 0) {
+            head_.store(head + count, std::memory_order_release);
+        }
+        return count;
+    }
+
+    // Approximate when called concurrently with the other side
+    size_t size() const {
+        return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+    }
+
+    bool empty() const { return size() == 0; }
+    size_t capacity() const { return capacity_; }
+};
+
+}
+}
@@ -0,0 +1,108 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include "EventRecord.h"
+#include "../common/SpscRing.h"
+
+namespace trading {
+namespace io {
+
+enum class WriterBackend {
+    AUTO,       // io_uring when the kernel allows it, pwritev otherwise
+    IO_URING,
+    PWRITEV
+};
+
+struct AsyncWriterConfig {
+    size_t ring_capacity = 1 << 16;         // records between producer and writer thread
+    size_t buffer_count = 8;                // registered I/O buffers
+    size_t buffer_size = 256 * 1024;        // bytes per buffer, multiple of sizeof(EventRecord)
+    WriterBackend backend = WriterBackend::AUTO;
+    bool truncate = true;
+    bool sync_on_close = false;
+};
+
+struct AsyncWriterStats {
+    WriterBackend backend = WriterBackend::AUTO;
+    uint64_t records_written = 0;
+    uint64_t bytes_written = 0;
+    uint64_t records_dropped = 0;   // try_write() calls that found the ring full
+    uint64_t producer_stalls = 0;   // write() calls that had to spin for space
+    uint64_t submissions = 0;       // io_uring_enter / pwritev calls issued
+    uint64_t io_errors = 0;
+    double elapsed_seconds = 0.0;
+    double megabytes_per_second = 0.0;
+
+    // Producer-side latency of write()/try_write(), in nanoseconds
+    uint64_t producer_p50_ns = 0;
+    uint64_t producer_p99_ns = 0;
+    uint64_t producer_p999_ns = 0;
+    uint64_t producer_max_ns = 0;
+};
+
+class WriterBackendImpl;
+
+// Asynchronous file writer for journal and market-data capture.
+//
+// The producer (matching thread) hands fixed-size EventRecords over an SPSC ring;
+// a dedicated writer thread packs them into preallocated buffers and submits
+// them in batches via io_uring with registered buffers, or via pwritev when
+// io_uring is unavailable. The producer never makes a syscall.
+class AsyncFileWriter {
+public:
+    explicit AsyncFileWriter(const std::string& path, const AsyncWriterConfig& config = AsyncWriterConfig());
+    ~AsyncFileWriter();
+
+    AsyncFileWriter(const AsyncFileWriter&) = delete;
+    AsyncFileWriter& operator=(const AsyncFileWriter&) = delete;
+
+    // Producer side - must be called from a single thread
+    bool try_write(const EventRecord& record);
+    void write(const EventRecord& record);
+
+    // Drains everything already pushed and stops the writer thread
+    void close();
+
+    // Safe to call from the producer thread, or from any thread after close()
+    AsyncWriterStats stats() const;
+
+    WriterBackend backend() const { return active_backend_; }
+
+private:
+    static constexpr size_t LATENCY_BUCKETS = 40;
+
+    concurrency::SpscRing<EventRecord> ring_;
+    std::unique_ptr<WriterBackendImpl> impl_;
+    WriterBackend active_backend_;
+    std::thread writer_thread_;
+    std::atomic<bool> stop_{false};
+    bool closed_ = false;
+    int fd_ = -1;
+    bool sync_on_close_ = false;
+    size_t records_per_buffer_ = 0;
+
+    // Writer counters captured at close()
+    uint64_t final_bytes_written_ = 0;
+    uint64_t final_submissions_ = 0;
+    uint64_t final_io_errors_ = 0;
+
+    std::chrono::steady_clock::time_point start_time_;
+    std::chrono::steady_clock::time_point stop_time_;
+
+    // Producer-owned counters
+    uint64_t records_dropped_ = 0;
+    uint64_t producer_stalls_ = 0;
+    uint64_t producer_max_ns_ = 0;
+    std::array<uint64_t, LATENCY_BUCKETS> latency_buckets_{};   // log2(ns) buckets
+
+    void record_latency(uint64_t ns);
+    void run();
+};
+
+}
+}
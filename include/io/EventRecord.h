@@ -0,0 +1,50 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+
+namespace trading {
+namespace io {
+
+enum class EventType : uint8_t {
+    NONE = 0,
+    ORDER_PLACED,
+    ORDER_CANCELLED,
+    ORDER_MODIFIED,
+    TRADE,
+    CHECKPOINT,
+    ORDER_EXTENSION,    // follows an ORDER_PLACED record carrying fields that did not fit
+    TIME_ADVANCED,      // book clock moved to timestamp_ns, expiring due orders
+    BOOK_CONFIG,        // journal header: how the recorded book was configured
+    TICK_BAND,          // follows BOOK_CONFIG, one per band of the tick table
+    MASS_CANCEL,        // every order of a participant matching a filter cancelled
+    AUCTION_STARTED,    // book moved into the call auction phase
+    UNCROSSED           // auction uncrossed at the reference price in `price`, book back to continuous
+};
+
+// Fixed-size record written by the journal and market-data writers.
+// Layout is stable on disk: one record per 64 bytes, no framing.
+struct alignas(64) EventRecord {
+    uint64_t sequence;
+    uint64_t timestamp_ns;
+    int64_t price;          // Price::raw_value()
+    int32_t order_id;
+    int32_t volume;
+    int32_t aux;            // event specific (counterparty order id, ...)
+    EventType type;
+    uint8_t side;           // 0 = buy, 1 = sell
+    uint8_t flags;
+    uint8_t order_type;     // OrderType for place records
+    char client[16];        // truncated, not necessarily null-terminated
+    uint64_t payload;       // event specific (checksum, ...)
+
+    void set_client(const char* name, size_t length) {
+        size_t n = length < sizeof(client) ? length : sizeof(client);
+        std::memset(client, 0, sizeof(client));
+        std::memcpy(client, name, n);
+    }
+};
+
+static_assert(sizeof(EventRecord) == 64, "EventRecord must stay one cache line");
+
+}
+}
@@ -0,0 +1,89 @@
+#pragma once
+#include <chrono>
+#include <string>
+#include <vector>
+#include "EventRecord.h"
+#include "../orderbook/Order.h"
+#include "../orderbook/OrderbookTypes.h"
+#include "../orderbook/TickTable.h"
+
+namespace trading {
+namespace io {
+
+// Command journal encoding.
+//
+// A journal is a flat file of EventRecords holding the commands applied to a book,
+// in order, interleaved with CHECKPOINT records. A checkpoint carries the book
+// checksum in `payload` and, when CHECKPOINT_HAS_OUTPUT_HASH is set in `flags`,
+// the output hash chain in the bits of `price`. ORDER_PLACED records carry the
+// order's TimeInForce in the low bits of `flags`, its protection band in `aux`
+// and its iceberg peak size in `payload`. Orders with more state than fits set
+// PLACE_HAS_EXTENSION and are followed by an ORDER_EXTENSION record with the same
+// sequence, carrying the stop price in `price`, the expire time in
+// `timestamp_ns` and the participant id in `aux`. TIME_ADVANCED records replay
+// the book's clock. MASS_CANCEL records carry the participant in `aux`, the
+// filter's sides in `flags` and its price bounds in `price` (min) and `payload`
+// (max). AUCTION_STARTED and UNCROSSED records replay the trading phase, the
+// latter with the uncross reference price in `price`.
+//
+// A journal may open with a BOOK_CONFIG record describing the recorded book: the
+// matching policy in `order_type` (a lead market maker's participant id in `aux`
+// and share in `volume`), the self-trade prevention mode in `side`, the session
+// end in `timestamp_ns` and the number of tick bands in `order_id`. That many
+// TICK_BAND records follow with the same sequence, each with its lower bound in
+// `price` and its tick in `payload`. Journals without a header were recorded
+// from a default FIFO book.
+
+constexpr uint8_t CHECKPOINT_HAS_OUTPUT_HASH = 0x01;
+constexpr uint8_t PLACE_TIME_IN_FORCE_MASK = 0x07;
+constexpr uint8_t PLACE_HAS_EXTENSION = 0x40;       // an ORDER_EXTENSION record follows
+constexpr uint8_t PLACE_WITH_LEVEL_FILLS = 0x80;    // placed through the level-fill overload
+constexpr uint8_t MASS_CANCEL_BUYS = 0x01;
+constexpr uint8_t MASS_CANCEL_SELLS = 0x02;
+
+enum class BookPolicy : uint8_t {
+    FIFO,
+    PRO_RATA,
+    FIFO_LMM
+};
+
+// Everything a replay needs to rebuild the recorded book before the first command
+struct BookConfig {
+    BookPolicy policy = BookPolicy::FIFO;
+    int lmm_participant_id = 0;
+    int lmm_percent = 0;
+    SelfTradePrevention stp_mode = SelfTradePrevention::NONE;
+    std::chrono::system_clock::time_point session_end{};
+    std::vector<TickTable::Band> tick_bands = TickTable().bands();
+};
+
+std::vector<EventRecord> make_config_records(uint64_t sequence, const BookConfig& config);
+
+// Decodes the header at the front of a journal into `config` and returns the
+// number of records it spans; 0, leaving `config` alone, when there is none.
+// Throws std::runtime_error if the header is truncated or names an unknown policy.
+size_t read_config(const std::vector<EventRecord>& journal, BookConfig& config);
+
+EventRecord make_place_record(uint64_t sequence, const Order& order, bool level_fills = false);
+bool needs_extension_record(const Order& order);
+EventRecord make_place_extension_record(uint64_t sequence, const Order& order);
+EventRecord make_cancel_record(uint64_t sequence, int order_id);
+EventRecord make_modify_record(uint64_t sequence, int order_id, const Price& new_price, int new_volume);
+EventRecord make_mass_cancel_record(uint64_t sequence, int participant_id, const MassCancelFilter& filter);
+EventRecord make_auction_record(uint64_t sequence);
+EventRecord make_uncross_record(uint64_t sequence, const Price& reference_price);
+EventRecord make_time_record(uint64_t sequence, std::chrono::system_clock::time_point now);
+EventRecord make_checkpoint_record(uint64_t sequence, uint64_t book_checksum);
+EventRecord make_checkpoint_record(uint64_t sequence, uint64_t book_checksum, uint64_t output_hash);
+
+// Rebuilds the order carried by an ORDER_PLACED record and its extension, if any
+Order order_from_record(const EventRecord& record, const EventRecord* extension = nullptr);
+
+// Rebuilds the filter carried by a MASS_CANCEL record
+MassCancelFilter mass_cancel_filter_from_record(const EventRecord& record);
+
+// Reads a whole journal file; throws std::system_error if it cannot be opened
+std::vector<EventRecord> read_journal(const std::string& path);
+
+}
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include <cstdint>
+#include "OrderbookTypes.h"
+#include "../common/FixedPoint.h"
+
+namespace trading {
+
+// Order-independent rolling checksum of book state.
+//
+// Every resting order and price level contributes one mixed 64-bit term and
+// the checksum is the XOR of all terms, so each mutation is applied in O(1) by
+// toggling the old term out and the new term in. Order terms also include the
+// id of the order ahead in the queue, which makes queue order part of the state.
+class BookChecksum {
+private:
+    uint64_t value_ = 0;
+
+public:
+    static uint64_t mix(uint64_t x) {
+        // splitmix64 finalizer
+        x += 0x9e3779b97f4a7c15ULL;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        return x ^ (x >> 31);
+    }
+
+    static uint64_t order_term(int order_id, const Price& price, int volume, int hidden_volume,
+                               Side side, int prev_order_id) {
+        uint64_t h = mix(static_cast<uint64_t>(static_cast<uint32_t>(order_id)) |
+                         (static_cast<uint64_t>(static_cast<uint32_t>(prev_order_id)) << 32));
+        h = mix(h ^ static_cast<uint64_t>(price.raw_value()));
+        h = mix(h ^ (static_cast<uint64_t>(static_cast<uint32_t>(volume)) << 1) ^
+                (static_cast<uint64_t>(static_cast<uint32_t>(hidden_volume)) << 33) ^
+                (side == Side::BUY ? 0 : 1));
+        return h;
+    }
+
+    static uint64_t level_term(const Price& price, int total_volume, int order_count, bool is_bid) {
+        uint64_t h = mix(static_cast<uint64_t>(price.raw_value()) ^ (is_bid ? 0x5bd1e995ULL : 0));
+        h = mix(h ^ (static_cast<uint64_t>(static_cast<uint32_t>(total_volume)) |
+                     (static_cast<uint64_t>(static_cast<uint32_t>(order_count)) << 32)));
+        return h;
+    }
+
+    void toggle(uint64_t term) { value_ ^= term; }
+    uint64_t value() const { return value_; }
+    void reset() { value_ = 0; }
+};
+
+}
@@ -0,0 +1,56 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <ostream>
+#include "OrderbookTypes.h"
+#include "../utils/PerfCounters.h"
+
+namespace trading {
+
+// Opt-in hardware counter profile of book operations. The harness wraps each
+// call it wants attributed:
+//
+//     profiler.measure(BookOperation::PLACE, [&] { book.place_order(order, trades); });
+//
+// Counter deltas are summed per operation (scaled when the kernel multiplexed
+// the group) and print() reports per-call averages. Each measurement costs two
+// read() syscalls, so profile runs are for attribution, not for timing. Without
+// counters measure() still runs and counts the call and print() says so.
+class BookProfiler {
+public:
+    struct Totals {
+        uint64_t calls = 0;
+        uint64_t unscheduled = 0;   // calls during which the group never ran
+        std::array<double, metrics::PERF_EVENT_COUNT> events{};
+    };
+
+    bool available() const { return counters_.available(); }
+
+    template <typename Fn>
+    void measure(BookOperation op, Fn&& fn) {
+        if (!counters_.available()) {
+            fn();
+            totals_[static_cast<size_t>(op)].calls++;
+            return;
+        }
+        counters_.read(before_);
+        fn();
+        counters_.read(after_);
+        accumulate(op);
+    }
+
+    const Totals& totals(BookOperation op) const { return totals_[static_cast<size_t>(op)]; }
+    void reset() { totals_ = {}; }
+
+    void print(std::ostream& out) const;
+
+private:
+    metrics::PerfCounterGroup counters_;
+    metrics::PerfSample before_;
+    metrics::PerfSample after_;
+    std::array<Totals, static_cast<size_t>(BookOperation::COUNT)> totals_{};
+
+    void accumulate(BookOperation op);
+};
+
+}
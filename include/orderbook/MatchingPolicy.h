@@ -0,0 +1,119 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include "Order.h"
+#include "PriceLevel.h"
+
+namespace trading {
+
+// Matching policies decide how an incoming order's quantity is split across the
+// orders resting at one price level. The book calls
+//
+//     policy.match(level, order, fill)
+//
+// with `fill(resting, volume)` executing one fill against a resting order and
+// returning whether that order is still queued at the level afterwards (partial
+// fill, refilled iceberg). `fill` reduces the incoming order's volume; it may also
+// zero it (self-trade prevention), so policies re-read it after every call. A
+// policy may leave volume unallocated - the book calls it again while the level
+// still crosses.
+
+// Strict price-time priority
+struct FifoMatching {
+    template <typename Fill>
+    void match(PriceLevel* level, Order* order, Fill&& fill) const {
+        Order* resting = level->head;
+        while (resting && order->get_volume() > 0) {
+            Order* next = resting->next;
+            bool queued = fill(resting, std::min(order->get_volume(), resting->get_volume()));
+
+            // Only a refilled iceberg stays queued with volume left to match; if it
+            // was the last order it is now the only candidate
+            if (queued && !next) {
+                next = resting;
+            }
+            resting = next;
+        }
+    }
+};
+
+// Pro-rata with top-order priority: the order at the front of the queue fills
+// first in full, the remainder is shared by displayed size across the rest.
+//
+// Shares use cumulative rounding - order i gets floor(Q * C_i / V) - floor(Q * C_(i-1) / V)
+// where C is the running displayed volume - so they are computed in a single
+// pass with integer arithmetic, never exceed an order's size, and always sum to
+// exactly Q with the rounding remainder going to the earliest orders that
+// straddle a boundary.
+struct ProRataMatching {
+    template <typename Fill>
+    void match(PriceLevel* level, Order* order, Fill&& fill) const {
+        Order* top = level->head;
+        if (!top) {
+            return;
+        }
+        fill(top, std::min(order->get_volume(), top->get_volume()));
+        if (order->get_volume() == 0) {
+            return;
+        }
+
+        int64_t quantity = order->get_volume();
+        int64_t total = level->get_total_volume();
+        if (quantity >= total) {
+            // Everyone fills in full - no allocation needed
+            FifoMatching().match(level, order, fill);
+            return;
+        }
+
+        // Orders requeued during the pass (refilled icebergs) are not revisited
+        int count = level->get_order_count();
+        int64_t cumulative = 0;
+        int64_t allocated = 0;
+        Order* resting = level->head;
+        for (int i = 0; i < count && resting && order->get_volume() > 0; ++i) {
+            Order* next = resting->next;
+
+            cumulative += resting->get_volume();
+            int64_t target = quantity * cumulative / total;
+            int share = static_cast<int>(target - allocated);
+            allocated = target;
+
+            if (share > 0) {
+                fill(resting, std::min(share, order->get_volume()));
+            }
+            resting = next;
+        }
+    }
+};
+
+// Price-time priority with a lead market maker allocation: the configured
+// participant's orders receive up to `lmm_percent` of the incoming quantity at a
+// level first (in time order), everything else then matches FIFO.
+struct FifoLmmMatching {
+    int lmm_participant_id = 0;     // 0 = no lead market maker
+    int lmm_percent = 0;
+
+    template <typename Fill>
+    void match(PriceLevel* level, Order* order, Fill&& fill) const {
+        if (lmm_participant_id != 0 && lmm_percent > 0) {
+            int guaranteed = static_cast<int>(static_cast<int64_t>(order->get_volume()) * lmm_percent / 100);
+
+            // Walk the orders present now; a refilled LMM iceberg moves to the tail
+            int count = level->get_order_count();
+            Order* resting = level->head;
+            for (int i = 0; i < count && resting && guaranteed > 0 && order->get_volume() > 0; ++i) {
+                Order* next = resting->next;
+                if (resting->get_participant_id() == lmm_participant_id) {
+                    int before = order->get_volume();
+                    fill(resting, std::min({guaranteed, before, resting->get_volume()}));
+                    guaranteed -= before - order->get_volume();
+                }
+                resting = next;
+            }
+        }
+
+        FifoMatching().match(level, order, fill);
+    }
+};
+
+}
@@ -6,6 +6,7 @@
 #include <string>
 #include "OrderbookTypes.h"
 #include "../common/FixedPoint.h"
+#include "../common/FixedString.h"
 
 namespace trading {
 
@@ -13,12 +14,20 @@ class PriceLevel;
 
 class Order {
 private:
-  	std::string client_;
+  	ClientName client_;
     Price price_;
     int order_id_;
     int volume_;
     Side side_;
     std::chrono::system_clock::time_point timestamp_;
+    TimeInForce time_in_force_ = TimeInForce::GTC;
+    OrderType order_type_ = OrderType::LIMIT;
+    int protection_ticks_ = 0;      // market orders: max ticks through the best price, 0 = unbounded
+    int peak_size_ = 0;             // iceberg orders: displayed quantity per refill, 0 = fully displayed
+    int hidden_volume_ = 0;         // iceberg reserve not yet displayed
+    Price stop_price_;              // stop orders: trigger price
+    std::chrono::system_clock::time_point expire_time_{};   // GTT orders: expiry time
+    int participant_id_ = 0;        // self-trade prevention group, 0 = none
 
     static int next_order_id_;
 public:
@@ -28,41 +37,71 @@ public:
 
     PriceLevel* level = nullptr;
 
+    // limit price as an index of the book's tick table, set once on entry
+    int64_t tick = 0;
+
+    // intrusive expiry timer list, owned by the book's TimerWheel
+    Order* timer_next = nullptr;
+    Order* timer_prev = nullptr;
+    int timer_slot = -1;
+    uint64_t timer_expiry = 0;
+
+    // intrusive per-participant list, owned by the book's ParticipantIndex
+    Order* participant_next = nullptr;
+    Order* participant_prev = nullptr;
+
     // Constructors
     Order();
 
     // Full control constructor
-    Order(std::string _client, Price _price, int _order_id, int _volume, Side _side, std::chrono::system_clock::time_point _timestamp);
+    Order(ClientName _client, Price _price, int _order_id, int _volume, Side _side, std::chrono::system_clock::time_point _timestamp);
 
     // Auto-generated order_id, manual timestamp
-    Order(std::string _client, Price _price, int _volume, Side _side, std::chrono::system_clock::time_point _timestamp);
+    Order(ClientName _client, Price _price, int _volume, Side _side, std::chrono::system_clock::time_point _timestamp);
 
     // Auto-generated order_id and timestamp
-    Order(std::string _client, Price _price, int _volume, Side _side);
+    Order(ClientName _client, Price _price, int _volume, Side _side);
 
     // Compatibility constructors with double price
-    Order(std::string _client, double _price, int _order_id, int _volume, Side _side, std::chrono::system_clock::time_point _timestamp);
-    Order(std::string _client, double _price, int _volume, Side _side, std::chrono::system_clock::time_point _timestamp);
-    Order(std::string _client, double _price, int _volume, Side _side);
+    Order(ClientName _client, double _price, int _order_id, int _volume, Side _side, std::chrono::system_clock::time_point _timestamp);
+    Order(ClientName _client, double _price, int _volume, Side _side, std::chrono::system_clock::time_point _timestamp);
+    Order(ClientName _client, double _price, int _volume, Side _side);
 
     // Reset auto-generated order ID counter (useful for tests)
     static void reset_order_id_counter(int start_id = 1);
     
     // Getters
-    std::string get_client() const;
+    const ClientName& get_client() const;
     Price get_price() const;
     int get_order_id() const;
     int get_volume() const;
     Side get_side() const;
     std::chrono::system_clock::time_point get_timestamp() const;
+    TimeInForce get_time_in_force() const;
+    OrderType get_order_type() const;
+    int get_protection_ticks() const;
+    int get_peak_size() const;
+    int get_hidden_volume() const;
+    Price get_stop_price() const;
+    std::chrono::system_clock::time_point get_expire_time() const;
+    int get_participant_id() const;
+    bool is_iceberg() const { return peak_size_ > 0; }
     
     // Setters
-    void set_client(std::string new_client);
+    void set_client(ClientName new_client);
     void set_price(Price new_price);
     void set_order_id(int new_order_id);
     void set_volume(int new_volume);
     void set_side(Side new_side);
     void set_timestamp(std::chrono::system_clock::time_point new_timestamp);
+    void set_time_in_force(TimeInForce new_time_in_force);
+    void set_order_type(OrderType new_order_type);
+    void set_protection_ticks(int new_protection_ticks);
+    void set_peak_size(int new_peak_size);
+    void set_hidden_volume(int new_hidden_volume);
+    void set_stop_price(Price new_stop_price);
+    void set_expire_time(std::chrono::system_clock::time_point new_expire_time);
+    void set_participant_id(int new_participant_id);
 };
 
 bool operator<(const Order& a, const Order& b);
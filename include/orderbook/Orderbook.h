@@ -1,53 +1,178 @@
 #pragma once
 
+#include <map>
+#include <memory>
 #include <vector>
-#include <unordered_map>
 #include "OrderbookTypes.h"
 #include "Order.h"
 #include "PriceLevel.h"
+#include "TimerWheel.h"
+#include "ParticipantIndex.h"
+#include "MatchingPolicy.h"
+#include "TradeAggregator.h"
+#include "TickTable.h"
 #include "../common/MemoryPool.h"
+#include "../common/FlatHashMap.h"
+#include "../utils/LatencyHistogram.h"
+#include "../utils/FlightRecorder.h"
+
+// Per-operation latency histograms; off by default, enabled with the CMake
+// option of the same name. When off the instrumentation compiles away entirely.
+#ifndef ORDERBOOK_LATENCY_STATS
+#define ORDERBOOK_LATENCY_STATS 0
+#endif
 
 namespace trading {
 
-class Orderbook {
+struct BookMemoryStats {
+    memory::PoolStats orders;
+    memory::PoolStats levels;
+};
+
+// Limit order book, parameterised on how a price level's queue is allocated
+// (see MatchingPolicy.h). Instantiated in Orderbook.cpp for the shipped policies.
+template <typename MatchingPolicy>
+class BasicOrderbook {
 public:
     // Constructor/destructor
-    Orderbook();
-    ~Orderbook();
+    BasicOrderbook();
+    explicit BasicOrderbook(Price tick_size);
+
+    // Limit and stop prices off the table's grid are rejected as INVALID_ORDER
+    explicit BasicOrderbook(const TickTable& tick_table);
+    ~BasicOrderbook();
 
 	// Disable copying
-    Orderbook(const Orderbook&) = delete;
-    Orderbook& operator=(const Orderbook&) = delete;
+    BasicOrderbook(const BasicOrderbook&) = delete;
+    BasicOrderbook& operator=(const BasicOrderbook&) = delete;
 
-    // Enable moving
-    Orderbook(Orderbook&&) noexcept;
-    Orderbook& operator=(Orderbook&&) noexcept;
+    // Moving or swapping hands over the pools, levels and every index in O(1)
+    // without allocating, so a book loaded or rebuilt on another thread can be
+    // swapped into place. Resting orders keep their addresses. A moved-from book
+    // is empty and usable, and is detached from the trade aggregator.
+    BasicOrderbook(BasicOrderbook&&) noexcept;
+    BasicOrderbook& operator=(BasicOrderbook&&) noexcept;
+    void swap(BasicOrderbook& other) noexcept;
 
     // Core functionality
     OrderResult place_order(const Order& order, std::vector<TradeInfo>& trades_executed);
+
+    // Levels the order consumes entirely are released in one pass and reported
+    // as a single LevelFillInfo instead of per-order TradeInfo entries
+    OrderResult place_order(const Order& order, std::vector<TradeInfo>& trades_executed,
+                            std::vector<LevelFillInfo>& level_fills);
     OrderResult cancel_order(int order_id);
+
+    // Cancels every order of a participant (cancel-on-disconnect, kill switch),
+    // visiting only that participant's orders. Returns the number cancelled.
+    size_t mass_cancel(int participant_id, const MassCancelFilter& filter = MassCancelFilter());
     OrderResult modify_order(int order_id, const Price& new_price, int new_volume);
 
+    // Amends in place: a volume decrease at the same price keeps queue position,
+    // anything else requeues the same order at the tail of its new level, matching
+    // first if the new price crosses. Fills are reported in trades_executed.
+    // For icebergs new_volume is the total left to trade, peak plus reserve; a
+    // decrease comes out of the reserve first and a requeue re-derives the peak.
+    OrderResult modify_order(int order_id, const Price& new_price, int new_volume,
+                             std::vector<TradeInfo>& trades_executed);
+
     OrderResult modify_order(int order_id, double new_price, int new_volume) {
 		return modify_order(order_id, Price(new_price), new_volume);
 	}
 
+    // Expiry - moves the book's clock forward and cancels every GTT/DAY order
+    // whose expiry has passed. Returns the number of orders expired.
+    size_t advance_time(std::chrono::system_clock::time_point now);
+    void set_session_end(std::chrono::system_clock::time_point session_end) { session_end_ = session_end; }
+    std::chrono::system_clock::time_point get_session_end() const { return session_end_; }
+    std::chrono::system_clock::time_point get_current_time() const { return current_time_; }
+
+    // Call auction - while in AUCTION, limit orders rest without matching (the book
+    // may cross) and market, IOC and FOK orders are rejected. uncross() executes at
+    // the equilibrium price in price-time priority and returns to continuous trading.
+    // A zero reference price falls back to the last trade price.
+    void begin_auction() { phase_ = TradingPhase::AUCTION; }
+    TradingPhase get_trading_phase() const { return phase_; }
+    AuctionResult indicative_uncross(Price reference_price = Price()) const;
+    AuctionResult uncross(std::vector<TradeInfo>& trades_executed, Price reference_price = Price());
+
+    // Runtime parameters of the matching policy, e.g. the lead market maker
+    MatchingPolicy& matching_policy() { return policy_; }
+    const MatchingPolicy& matching_policy() const { return policy_; }
+
+    // Self-trade prevention between orders sharing a non-zero participant id
+    void set_self_trade_prevention(SelfTradePrevention mode) { stp_mode_ = mode; }
+    SelfTradePrevention get_self_trade_prevention() const { return stp_mode_; }
+
     // Market data access
     std::vector<BookLevel> get_bid_levels(int depth = 10) const;
     std::vector<BookLevel> get_ask_levels(int depth = 10) const;
     Price get_mid_price() const;
     Price get_best_bid() const;
     Price get_best_ask() const;
+    Price get_tick_size() const { return tick_size_; }
+    const TickTable& get_tick_table() const { return tick_table_; }
+    Price get_last_trade_price() const { return last_trade_price_; }
     int get_volume_at_price(const Price& price, Side side) const;
 
+    // Microprice, imbalance and top-SIGNAL_DEPTH cumulative depth. The sides keep
+    // their depth windows current as levels change, so this is O(1); publish it
+    // with concurrency::SeqLock<BookSignals> for readers on other threads.
+    BookSignals signals() const;
+
+    // Cumulative depth of one resting side (BUY = bids), including iceberg
+    // reserve, in O(log ticks) from the sides' tick-volume indexes:
+    // volume at or better than a price, the worst price a sweep of `volume`
+    // reaches (zero if the side holds less), and volume within `ticks` of the best
+    int64_t cumulative_volume(Side side, const Price& price) const;
+    Price price_for_volume(Side side, int64_t volume) const;
+    int64_t volume_within_ticks(Side side, int ticks) const;
+
     int get_volume_at_price(double price, Side side) const {
 		return get_volume_at_price(Price(price), side);
 	}
 
 	// Metrics
 	size_t order_count() const { return order_map_.size(); }
+	bool has_order(int order_id) const { return order_map_.find(order_id) != order_map_.end(); }
 	size_t price_level_count() const;
 
+	// Per-side level, order and volume totals plus pool occupancy, all kept
+	// current as the book changes, so this is O(1) at any depth. Monitoring
+	// threads should read a copy published with concurrency::SeqLock<BookStats>
+	// from the book's thread rather than call into the book.
+	BookStats stats() const;
+
+	// Pool footprint and churn, see memory::PoolStats
+	BookMemoryStats memory_stats() const;
+
+	// Releases empty pool blocks beyond `spare_blocks` per pool and shrinks the
+	// lookup tables to the live book, so memory follows book size after a busy
+	// period. Call between batches on the book's own thread; live orders and
+	// levels never move, so pointers held across the call stay valid. Returns
+	// the number of blocks released.
+	size_t trim_memory(size_t spare_blocks = 1);
+
+	// Cheap enough for every batch boundary: trims only once at least
+	// `empty_fraction` of either pool's blocks are empty
+	size_t compaction_point(double empty_fraction = 0.25, size_t spare_blocks = 1);
+
+	// Integrity - rolling checksum of both sides, comparable across runs and replicas
+	uint64_t checksum() const { return bid_levels_.checksum() ^ ask_levels_.checksum(); }
+
+	// Optional VWAP/bar aggregation of every fill, timed by the aggressing order's
+	// timestamp. The aggregator is not owned and must outlive its attachment.
+	void set_trade_aggregator(TradeAggregator* aggregator) { aggregator_ = aggregator; }
+
+	// Optional hash chain over every trade reported by the book
+	void set_output_hash_chain(bool enabled) { output_hash_enabled_ = enabled; }
+	uint64_t output_hash() const { return output_hash_; }
+
+	// Latency of each operation (see ORDERBOOK_LATENCY_STATS); empty when disabled.
+	// CANCEL includes cancels issued by advance_time for expired orders.
+	metrics::LatencySummary latency_summary(BookOperation op) const;
+	void reset_latency_stats();
+
     // Debug functionality
     void print_book() const;
 
@@ -61,17 +186,124 @@ private:
 	PriceLevelList ask_levels_;
 
 	// Direct lookup
-	std::unordered_map<int, Order*> order_map_;
+	FlatHashMap<int, Order*> order_map_;
+
+	MatchingPolicy policy_;
+
+	// Price grid of the instrument; tick_size_ is its smallest increment. Limits
+	// are converted to tick indices once on entry and the levels, matching and
+	// stop triggers work on those
+	TickTable tick_table_;
+	Price tick_size_;
+
+	TradingPhase phase_ = TradingPhase::CONTINUOUS;
+
+	// Pending stop orders keyed by trigger tick, FIFO within a trigger
+	std::map<int64_t, PriceLevel*> buy_stops_;
+	std::map<int64_t, PriceLevel*> sell_stops_;
+	std::vector<Order*> triggered_stops_;
+	Price last_trade_price_;
+	uint64_t trade_count_ = 0;
+
+	// Order expiry, at millisecond resolution
+	static constexpr std::chrono::milliseconds TIMER_RESOLUTION{1};
+	TimerWheel timer_wheel_;
+	std::vector<Order*> expired_orders_;
+	std::chrono::system_clock::time_point current_time_{};
+	std::chrono::system_clock::time_point session_end_{};
+
+	// Orders by participant, for mass cancel
+	ParticipantIndex participants_;
+	std::vector<std::pair<Side, PriceLevel*>> emptied_levels_;
+
+	// Self-trade prevention
+	SelfTradePrevention stp_mode_ = SelfTradePrevention::NONE;
+	bool stp_cancelled_ = false;    // aggressor was cancelled by self-trade prevention
+	bool stp_decremented_ = false;  // aggressor quantity was shrunk by DECREMENT_AND_CANCEL
+
+	// Sink for fills of modify_order calls that don't ask for them
+	std::vector<TradeInfo> discarded_trades_;
+
+	// Output hash chain
+	bool output_hash_enabled_ = false;
+	uint64_t output_hash_ = 0;
+
+	TradeAggregator* aggregator_ = nullptr;
+
+#if ORDERBOOK_LATENCY_STATS
+	// Behind a pointer so moves don't copy the histograms; a moved-from book
+	// allocates fresh ones on its next timed operation
+	using LatencyHistograms = std::array<metrics::LatencyHistogram, static_cast<size_t>(BookOperation::COUNT)>;
+	std::unique_ptr<LatencyHistograms> latency_;
+	metrics::LatencyHistogram& latency_histogram(BookOperation op);
+#endif
 
 	// Order matching logic
-    OrderResult match_against_asks(Order* order, std::vector<TradeInfo>& trades);
-    OrderResult match_against_bids(Order* order, std::vector<TradeInfo>& trades);
+    OrderResult execute_order(const Order& order, std::vector<TradeInfo>& trades,
+                              std::vector<LevelFillInfo>* level_fills);
+    bool admit_order(const Order& order, Price& limit) const;
+    OrderResult match_and_rest(Order* order, std::vector<TradeInfo>& trades,
+                               std::vector<LevelFillInfo>* level_fills);
+    OrderResult match_against_asks(Order* order, std::vector<TradeInfo>& trades,
+                                   std::vector<LevelFillInfo>* level_fills);
+    OrderResult match_against_bids(Order* order, std::vector<TradeInfo>& trades,
+                                   std::vector<LevelFillInfo>* level_fills);
+    void match_level(PriceLevelList& levels, PriceLevel* level, Order* order,
+                     std::vector<TradeInfo>& trades);
+    bool fill_resting(PriceLevelList& levels, PriceLevel* level, Order* order, Order* resting,
+                      int volume, std::vector<TradeInfo>& trades);
+    bool reduce_resting(PriceLevelList& levels, PriceLevel* level, Order* resting, int volume);
+    void rest_order(Order* order);
+    void queue_order(Order* order);
+    void record_trade(const Order* order, const Order* counterparty, const Price& price, int volume,
+                      std::vector<TradeInfo>& trades);
+    void sweep_level(PriceLevelList& levels, PriceLevel* level, Order* order,
+                     std::vector<LevelFillInfo>& level_fills);
+    Price market_limit_price(const Order& order) const;
+    void remove_resting(PriceLevelList& levels, PriceLevel* level, Order* resting);
+
+    // Self-trade prevention
+    bool stp_applies(const Order* order) const {
+        return stp_mode_ != SelfTradePrevention::NONE && order->get_participant_id() != 0;
+    }
+    bool prevent_self_trade(PriceLevelList& levels, PriceLevel* level, Order* order, Order* resting);
+
+    // Stop orders
+    static bool is_stop_order(const Order& order) {
+        return order.get_order_type() == OrderType::STOP || order.get_order_type() == OrderType::STOP_LIMIT;
+    }
+    bool has_pending_stops() const { return !buy_stops_.empty() || !sell_stops_.empty(); }
+    OrderResult place_stop(const Order& order, std::vector<TradeInfo>& trades,
+                           std::vector<LevelFillInfo>* level_fills);
+    void remove_stop(Order* stop);
+    void collect_triggered_stops();
+    void release_stop_bucket(PriceLevel* bucket);
+    void run_stop_cascade(std::vector<TradeInfo>& trades, std::vector<LevelFillInfo>* level_fills);
+
+    // Order expiry
+    static bool has_expiry(const Order& order) {
+        return order.get_time_in_force() == TimeInForce::GTT || order.get_time_in_force() == TimeInForce::DAY;
+    }
+    std::chrono::system_clock::time_point expire_time_of(const Order& order) const;
+    void schedule_expiry(Order* order);
 
     // Order management
+    Order* allocate_order(const Order& order);
+    void set_limit(Order* order, const Price& limit) const {
+        order->set_price(limit);
+        order->tick = tick_table_.to_index(limit);
+    }
     void add_order_to_book(Order* order);
     bool is_valid_order(const Order& order) const;
     bool has_duplicate_id(const Order& order) const;
+    bool can_fill_completely(const Order& order, const Price& limit) const;
+    void aggregate_fill(const Order* aggressor, const Price& price, int volume);
+    void chain_output(int order_id, const Price& price, int volume, bool is_buy);
 };
 
+using Orderbook = BasicOrderbook<FifoMatching>;
+using ProRataOrderbook = BasicOrderbook<ProRataMatching>;
+using FifoLmmOrderbook = BasicOrderbook<FifoLmmMatching>;
+
 
 }
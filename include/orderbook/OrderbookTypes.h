@@ -1,8 +1,10 @@
 #pragma once
+#include <cstdint>
 #include <vector>
 #include <string>
 #include <ctime>
 #include "../common/FixedPoint.h"
+#include "../common/FixedString.h"
 #include <unordered_map>
 
 namespace trading {
@@ -13,6 +15,38 @@ enum class Side {
     SELL
 };
 
+// Order type
+enum class OrderType {
+    LIMIT,
+    MARKET,     // executes against the opposite side, optionally bounded by a protection band
+    STOP,       // becomes a market order once the last trade reaches the stop price
+    STOP_LIMIT  // becomes a limit order once the last trade reaches the stop price
+};
+
+// How long an order may rest in the book
+enum class TimeInForce {
+    GTC,    // good till cancelled
+    IOC,    // immediate or cancel - unfilled remainder is cancelled
+    FOK,    // fill or kill - executes in full immediately or not at all
+    GTT,    // good till time - expires at the order's expire time
+    DAY     // expires at the end of the book's trading session
+};
+
+// What happens when an order would trade against a resting order of the same participant
+enum class SelfTradePrevention {
+    NONE,
+    CANCEL_NEWEST,          // cancel the incoming order's remainder
+    CANCEL_OLDEST,          // cancel the resting order and keep matching
+    CANCEL_BOTH,
+    DECREMENT_AND_CANCEL    // reduce both by the smaller size, cancelling whichever reaches zero
+};
+
+// Continuous matching, or a call auction collecting orders for a later uncross
+enum class TradingPhase {
+    CONTINUOUS,
+    AUCTION
+};
+
 // Result of order operations
 enum class OrderResult {
     SUCCESS,
@@ -21,17 +55,27 @@ enum class OrderResult {
     REJECTED,
     INVALID_ORDER,
     ORDER_NOT_FOUND,
-    DUPLICATE_ORDER_ID
+    DUPLICATE_ORDER_ID,
+    CANCELLED           // IOC/FOK remainder cancelled instead of resting
 };
 
 // Trrade execution information
 struct TradeInfo {
     int order_id;
-    std::string client_name;
+    ClientName client_name;
+    Price price;
+    int volume;
+    bool is_buy;
+    ClientName counterparty;
+};
+
+// Aggregated execution against every order resting at one price level
+struct LevelFillInfo {
+    int order_id;       // aggressing order
     Price price;
     int volume;
+    int order_count;    // resting orders consumed
     bool is_buy;
-    std::string counterparty;
 };
 
 // Market data price level
@@ -41,4 +85,65 @@ struct BookLevel {
     int order_count;
 };
 
+// Levels per side covered by BookSignals depth
+constexpr int SIGNAL_DEPTH = 5;
+
+// Top-of-book signals, maintained incrementally by the book. Trivially copyable
+// so it can be published through a SeqLock.
+struct BookSignals {
+    Price best_bid;                 // zero when the side is empty
+    Price best_ask;
+    Price microprice;               // touch prices weighted by the opposite size; zero unless two-sided
+    int32_t imbalance_bp = 0;       // (bid - ask) / (bid + ask) touch volume, in basis points
+    int32_t bid_levels = 0;         // levels counted in bid_depth, up to SIGNAL_DEPTH
+    int32_t ask_levels = 0;
+    int64_t bid_depth[SIGNAL_DEPTH] = {};   // cumulative displayed volume over the top 1..N levels
+    int64_t ask_depth[SIGNAL_DEPTH] = {};
+};
+
+// Resting totals for one side of the book
+struct SideStats {
+    int32_t levels = 0;
+    int32_t orders = 0;
+    int64_t displayed_volume = 0;
+    int64_t hidden_volume = 0;      // iceberg reserve
+};
+
+// Book-wide statistics, all maintained incrementally so a snapshot is O(1).
+// Trivially copyable, like BookSignals, for publishing through a SeqLock.
+struct BookStats {
+    SideStats bids;
+    SideStats asks;
+    uint64_t orders = 0;            // resting orders plus pending stops
+    uint64_t trades = 0;
+    uint64_t order_pool_used = 0;
+    uint64_t order_pool_capacity = 0;
+    uint64_t level_pool_used = 0;
+    uint64_t level_pool_capacity = 0;
+};
+
+// Selects which of a participant's orders a mass cancel removes
+struct MassCancelFilter {
+    bool include_buys = true;
+    bool include_sells = true;
+    Price min_price;    // inclusive, zero = unbounded
+    Price max_price;    // inclusive, zero = unbounded
+};
+
+// Equilibrium of a call auction
+struct AuctionResult {
+    Price price;            // uncross price, zero when the book does not cross
+    int64_t volume = 0;     // executable volume at that price
+    int64_t imbalance = 0;  // unmatched volume at that price, positive = buy surplus
+};
+
+// Book operations with their own latency histogram
+enum class BookOperation {
+    PLACE,
+    CANCEL,
+    MODIFY,
+    MATCH,      // one match_against_* pass, nested inside PLACE/MODIFY
+    COUNT
+};
+
 }
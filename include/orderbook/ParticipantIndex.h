@@ -0,0 +1,26 @@
+#pragma once
+#include "Order.h"
+#include "../common/FlatHashMap.h"
+
+namespace trading {
+
+// Per-participant intrusive order lists, threaded through
+// Order::participant_next/participant_prev.
+//
+// Orders are pushed at the front, so the oldest orders - the ones fills usually
+// remove - sit at the back and unlink without touching the map. Only unlinking a
+// list head looks up the participant.
+class ParticipantIndex {
+public:
+    // Orders with participant id 0 are never indexed
+    void link(Order* order);
+    void unlink(Order* order);
+
+    // Newest first; nullptr when the participant has no orders
+    Order* head(int participant_id) const;
+
+private:
+    FlatHashMap<int, Order*> heads_;
+};
+
+}
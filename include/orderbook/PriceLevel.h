@@ -1,15 +1,20 @@
 #pragma once
 #include "Order.h"
+#include "BookChecksum.h"
+#include "TickVolumeIndex.h"
+#include "../utils/FlightRecorder.h"
 #include "../common/FixedPoint.h"
 #include "../common/MemoryPool.h"
-#include <unordered_map>
+#include "../common/FlatHashMap.h"
 
 namespace trading {
 
 class PriceLevel {
 private:
     Price price_;
-    int total_volume_ = 0;
+    int64_t tick_;              // price as an index of the book's tick table
+    int total_volume_ = 0;      // displayed quantity only
+    int hidden_volume_ = 0;     // iceberg reserves behind the displayed quantity
     int order_count_ = 0;
 
 public:
@@ -22,17 +27,26 @@ public:
     PriceLevel* prev_price = nullptr;
     
     // constructors
-    explicit PriceLevel(const Price& price);
+    PriceLevel(const Price& price, int64_t tick);
     
     // accessors
     Price get_price() const;
+    int64_t get_tick() const { return tick_; }
     int get_total_volume() const;
+    int get_hidden_volume() const;
     int get_order_count() const;
+
+    // Displayed plus iceberg reserve - what an aggressor can take here
+    int64_t get_executable_volume() const { return static_cast<int64_t>(total_volume_) + hidden_volume_; }
     
     // order management
     void add_order(Order* order);
     void remove_order(Order* order);
     void update_volume(Order* order, int old_volume);
+    void resize(Order* order, int volume, int hidden_volume);
+
+    // Detaches the whole queue without visiting the orders
+    void clear();
 };
 
 // Manages a linked list of price levels
@@ -41,18 +55,81 @@ private:
     PriceLevel* head_ = nullptr;
     PriceLevel* tail_ = nullptr;
     bool is_bid_side_;
-	memory::MemoryPool<PriceLevel>& pool_;
+	memory::MemoryPool<PriceLevel>* pool_;     // owned by the book, rebound when the book moves
     
-    // fast lookup by price
-    std::unordered_map<Price, PriceLevel*, std::hash<Price>> price_map_;
+    // fast lookup by tick index
+    FlatHashMap<int64_t, PriceLevel*> price_map_;
+
+    // rolling checksum of every level and order on this side
+    BookChecksum checksum_;
+
+    uint64_t level_term(const PriceLevel* level) const;
+    uint64_t order_term(const Order* order, int volume, int prev_id) const;
+
+    // Cumulative displayed volume over the best SIGNAL_DEPTH levels, refreshed
+    // only when a change touches a level inside that window
+    int64_t top_depth_[SIGNAL_DEPTH] = {};
+    int top_levels_ = 0;
+    int64_t top_boundary_ = 0;  // tick of the deepest level in the window
+
+    bool within_top(int64_t tick) const {
+        return top_levels_ < SIGNAL_DEPTH || (is_bid_side_ ? tick >= top_boundary_ : tick <= top_boundary_);
+    }
+    void refresh_top();
+
+    // Executable volume per tick, for cumulative depth queries
+    TickVolumeIndex depth_index_;
+    void index_volume(const PriceLevel* level, int64_t old_volume);
+    void rebuild_depth_index();
+
+    // Running totals for the whole side
+    SideStats stats_;
+
+    struct LevelTotals {
+        int64_t displayed = 0;
+        int64_t hidden = 0;
+        int orders = 0;
+    };
+    static LevelTotals totals_of(const PriceLevel* level) {
+        return LevelTotals{level->get_total_volume(), level->get_hidden_volume(), level->get_order_count()};
+    }
+
+    // Every mutation reports the level's totals from before it
+    void level_changed(const PriceLevel* level, const LevelTotals& before) {
+        LevelTotals after = totals_of(level);
+        stats_.displayed_volume += after.displayed - before.displayed;
+        stats_.hidden_volume += after.hidden - before.hidden;
+        stats_.orders += after.orders - before.orders;
+
+        if (after.displayed + after.hidden != before.displayed + before.hidden) {
+            index_volume(level, before.displayed + before.hidden);
+        }
+        if (within_top(level->get_tick())) {
+            refresh_top();
+        }
+    }
 
 public:
-	explicit PriceLevelList(bool is_bid_side, memory::MemoryPool<PriceLevel>& pool)
-        : head_(nullptr), tail_(nullptr), is_bid_side_(is_bid_side), pool_(pool) {}
+	// Allocates nothing until the first level is created
+	explicit PriceLevelList(bool is_bid_side, memory::MemoryPool<PriceLevel>& pool) noexcept
+        : head_(nullptr), tail_(nullptr), is_bid_side_(is_bid_side), pool_(&pool), depth_index_(is_bid_side) {}
 
-    
-    PriceLevel* find_level(const Price& price) const;
-    PriceLevel* create_level(const Price& price);
+    // Takes over other's levels, which must live in `pool`; other is left empty
+    // and still allocating from its own pool
+    PriceLevelList(PriceLevelList&& other, memory::MemoryPool<PriceLevel>& pool) noexcept
+        : PriceLevelList(other.is_bid_side_, pool) { swap(other); }
+
+    PriceLevelList(const PriceLevelList&) = delete;
+    PriceLevelList& operator=(const PriceLevelList&) = delete;
+
+    // Exchanges levels and every derived index; each list keeps its pool, so
+    // the owners swap their pools alongside
+    void swap(PriceLevelList& other) noexcept;
+
+    // Levels are keyed and ordered by tick index; the price is carried for
+    // reporting and the checksum
+    PriceLevel* find_level(int64_t tick) const;
+    PriceLevel* create_level(const Price& price, int64_t tick);
     void remove_level(PriceLevel* level);
     
     PriceLevel* get_best_level() const;
@@ -61,6 +138,38 @@ public:
     // iterate through price levels
     PriceLevel* begin() const;
     PriceLevel* next(PriceLevel* current) const;
+
+    // order management - routes level mutations through the side checksum
+    void add_order(PriceLevel* level, Order* order);
+    void remove_order(PriceLevel* level, Order* order);
+    void update_volume(PriceLevel* level, Order* order, int old_volume);
+    void clear_level(PriceLevel* level);
+
+    // Sets an order's displayed and reserve quantities in place, keeping its queue position
+    void resize(PriceLevel* level, Order* order, int volume, int hidden_volume);
+
+    // Refills a filled iceberg peak from its reserve and requeues the same order at the tail
+    void replenish(PriceLevel* level, Order* order);
+
+    uint64_t checksum() const { return checksum_.value(); }
+
+    // Level, order and volume totals for the side, kept current by every mutation
+    const SideStats& stats() const { return stats_; }
+    int level_count() const { return stats_.levels; }
+
+    // Depth window: top_depth()[i] is the displayed volume of the best i + 1 levels
+    const int64_t* top_depth() const { return top_depth_; }
+    int top_level_count() const { return top_levels_; }
+
+    // Cumulative executable volume, O(log ticks): at ticks at or better than
+    // `tick`, and the tick at which the best-first total first reaches `volume`
+    // (zero when the side holds less)
+    int64_t volume_through(int64_t tick) const { return depth_index_.volume_through(tick); }
+    int64_t tick_reaching(int64_t volume) const { return depth_index_.tick_reaching(volume); }
+    int64_t total_volume() const { return depth_index_.total(); }
+
+    // Shrinks the price lookup to the levels present
+    void shrink_lookup() { price_map_.rehash(0); }
 };
 
 }
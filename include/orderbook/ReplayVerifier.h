@@ -0,0 +1,51 @@
+#pragma once
+#include <string>
+#include <vector>
+#include "Orderbook.h"
+#include "BookProfiler.h"
+#include "../io/EventRecord.h"
+#include "../io/Journal.h"
+
+namespace trading {
+
+struct ReplayReport {
+    bool consistent = true;
+    uint64_t records_applied = 0;
+    uint64_t checkpoints_verified = 0;
+
+    // Populated for the first checkpoint that did not match
+    uint64_t mismatch_sequence = 0;
+    uint64_t expected_checksum = 0;
+    uint64_t actual_checksum = 0;
+    uint64_t expected_output_hash = 0;
+    uint64_t actual_output_hash = 0;
+};
+
+// Re-runs a command journal against a fresh book and compares the book checksum
+// (and output hash chain, when recorded) at every checkpoint. The fresh book is
+// built from the journal's BOOK_CONFIG header - policy, tick table, self-trade
+// prevention and session end - or is a default FIFO book without one.
+class ReplayVerifier {
+public:
+    // Applies a single journal command; checkpoints and unknown records are ignored.
+    // `extension` is the ORDER_EXTENSION record following a place, if flagged.
+    // Instantiated for the shipped book types.
+    template <typename Book>
+    static OrderResult apply(Book& book, const io::EventRecord& record, std::vector<TradeInfo>& trades,
+                             const io::EventRecord* extension = nullptr);
+
+    // The header a journal of `book` starts with (see io::make_config_records)
+    template <typename Book>
+    static io::BookConfig config_of(const Book& book);
+
+    // With a profiler, each place/cancel/modify is attributed to its operation
+    ReplayReport verify(const std::vector<io::EventRecord>& journal, BookProfiler* profiler = nullptr) const;
+    ReplayReport verify_file(const std::string& path, BookProfiler* profiler = nullptr) const;
+
+private:
+    template <typename Book>
+    ReplayReport replay(Book& book, const std::vector<io::EventRecord>& journal, size_t first,
+                        BookProfiler* profiler) const;
+};
+
+}
@@ -0,0 +1,83 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "../common/FixedPoint.h"
+
+namespace trading {
+
+// Tick size schedule of one instrument: price bands from a lower bound
+// upwards, each with its own minimum increment (say 0.0001 below 1.00 and
+// 0.01 from there). Valid prices map to a dense integer tick index, so
+// "n ticks through the best" is index arithmetic even across band edges.
+// Tables are immutable and copies share the bands, so copying one into a
+// book, or moving a book, never allocates.
+class TickTable {
+public:
+    struct Band {
+        Price from;     // inclusive lower bound; the first band starts at 0
+        Price tick;
+    };
+
+    // One band: every multiple of `tick`
+    explicit TickTable(Price tick = Price::fromRaw(100));
+
+    // Throws std::invalid_argument unless the first band starts at 0, bounds
+    // ascend, ticks are positive and each bound lies on the grid below it
+    explicit TickTable(const std::vector<Band>& bands);
+
+    // Copies share the bands; declared so moves copy too and never leave a
+    // table without bands
+    TickTable(const TickTable&) = default;
+    TickTable& operator=(const TickTable&) = default;
+
+    Price tick_at(Price price) const { return Price::fromRaw(band_of(price.raw_value()).tick); }
+    Price min_tick() const { return Price::fromRaw(min_tick_); }
+    std::vector<Band> bands() const;
+
+    // Positive and on the grid of its band
+    bool is_valid(Price price) const {
+        int64_t raw = price.raw_value();
+        const Entry& band = band_of(raw);
+        return raw > 0 && (raw - band.from) % band.tick == 0;
+    }
+
+    // Index of the grid price at or below `price`; from_index inverts it for
+    // grid prices
+    int64_t to_index(Price price) const {
+        int64_t raw = price.raw_value();
+        const Entry& band = band_of(raw);
+        int64_t offset = raw - band.from;
+        int64_t steps = offset / band.tick;
+        if (offset % band.tick != 0 && offset < 0) {
+            steps--;
+        }
+        return band.base_index + steps;
+    }
+    Price from_index(int64_t index) const;
+
+    // The grid price `ticks` steps from `price` (negative moves down)
+    Price offset(Price price, int64_t ticks) const { return from_index(to_index(price) + ticks); }
+
+private:
+    struct Entry {
+        int64_t from;
+        int64_t tick;
+        int64_t base_index;     // tick index of `from`
+    };
+
+    std::shared_ptr<const std::vector<Entry>> bands_;
+    int64_t min_tick_;
+
+    // Schedules have a handful of bands, and most have one
+    const Entry& band_of(int64_t raw) const {
+        const std::vector<Entry>& bands = *bands_;
+        size_t i = bands.size() - 1;
+        while (i > 0 && raw < bands[i].from) {
+            i--;
+        }
+        return bands[i];
+    }
+};
+
+}
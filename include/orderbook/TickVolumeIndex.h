@@ -0,0 +1,59 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace trading {
+
+// Fenwick tree of resting volume per tick index for one side of the book.
+//
+// Ticks are indexed best-first - ascending for asks, descending for bids - so a
+// prefix sum is the volume at or better than a tick and "where does the
+// cumulative volume reach X" is a single O(log n) descent. The window covers a
+// power-of-two number of ticks around the levels present and is rebuilt by the
+// owning PriceLevelList when a tick falls outside it.
+class TickVolumeIndex {
+public:
+    static constexpr size_t MIN_TICKS = 1024;
+    static constexpr size_t MAX_TICKS = size_t(1) << 20;
+
+    explicit TickVolumeIndex(bool descending) : descending_(descending) {}
+
+    bool covers(int64_t tick) const {
+        return size_ > 0 && tick >= base_tick_ && tick < base_tick_ + static_cast<int64_t>(size_);
+    }
+    // True when the window is at its size limit and the tick lies beyond its worst edge
+    bool beyond_worst_edge(int64_t tick) const;
+
+    // Drops everything and sizes the window for ticks in [lo, hi]; when that is
+    // wider than MAX_TICKS the window starts at `best` and worse ticks share the
+    // last bucket
+    void reset(int64_t lo, int64_t hi, int64_t best);
+    void clear();
+
+    // The tick must be covered, or beyond the worst edge (then it is clamped)
+    void add(int64_t tick, int64_t delta);
+
+    int64_t total() const { return total_; }
+
+    // Volume at ticks at or better than `tick`
+    int64_t volume_through(int64_t tick) const;
+
+    // Tick at which the best-first cumulative volume first reaches `volume`;
+    // 0 when the side holds less
+    int64_t tick_reaching(int64_t volume) const;
+
+private:
+    bool descending_;
+    int64_t base_tick_ = 0;
+    size_t size_ = 0;
+    size_t log_size_ = 0;
+    std::vector<int64_t> tree_;     // 1-based Fenwick array
+    int64_t total_ = 0;
+
+    // 0-based best-first position of a tick, clamped to the window
+    size_t position_of(int64_t tick) const;
+    int64_t tick_at(size_t position) const;
+};
+
+}
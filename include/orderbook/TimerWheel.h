@@ -0,0 +1,81 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "Order.h"
+
+namespace trading {
+
+// Hierarchical timer wheel for order expiry.
+//
+// Four levels of 256 slots; level n covers 256^(n+1) ticks ahead of the current
+// tick. Slots are intrusive lists threaded through Order::timer_next/timer_prev,
+// so scheduling and cancelling are O(1) and never allocate. Entries in an upper
+// level are cascaded down when the wheel reaches their block, and empty stretches
+// of time are skipped a whole block at a time. The slot table is allocated on the
+// first schedule, so an idle wheel is small and moves without allocating.
+//
+// Ticks are absolute (the book uses epoch milliseconds). The owner starts the
+// wheel at its clock before scheduling, otherwise the first advance walks the
+// whole gap from tick 0 a top-level block at a time.
+class TimerWheel {
+public:
+    static constexpr int LEVELS = 4;
+    static constexpr int SLOT_BITS = 8;
+    static constexpr int SLOTS = 1 << SLOT_BITS;
+
+    TimerWheel() = default;
+
+    // The wheel links orders of its owner; moving hands them over and leaves
+    // the source empty
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+    TimerWheel(TimerWheel&& other) noexcept { swap(other); }
+    TimerWheel& operator=(TimerWheel&& other) noexcept {
+        TimerWheel moved(std::move(other));
+        swap(moved);
+        return *this;
+    }
+
+    void swap(TimerWheel& other) noexcept {
+        slots_.swap(other.slots_);
+        std::swap(level_counts_, other.level_counts_);
+        std::swap(current_, other.current_);
+        std::swap(count_, other.count_);
+    }
+
+    // Moves an idle wheel to `tick`; ignored while anything is scheduled
+    void start(uint64_t tick) {
+        if (count_ == 0) {
+            current_ = tick;
+        }
+    }
+
+    // Expiry must be later than the current tick; earlier ones fire on the next tick
+    void schedule(Order* order, uint64_t expiry_tick);
+
+    // No-op if the order is not scheduled
+    void cancel(Order* order);
+
+    // Moves the wheel to `tick` and appends every order whose expiry is <= tick
+    void advance(uint64_t tick, std::vector<Order*>& expired);
+
+    bool is_scheduled(const Order* order) const { return order->timer_slot >= 0; }
+    uint64_t current_tick() const { return current_; }
+    size_t size() const { return count_; }
+
+private:
+    std::vector<Order*> slots_;     // LEVELS * SLOTS list heads once anything is scheduled
+    std::array<size_t, LEVELS> level_counts_{};
+    uint64_t current_ = 0;
+    size_t count_ = 0;
+
+    void link(Order* order, int slot);
+    void unlink(Order* order);
+    void place(Order* order, uint64_t expiry_tick);
+    void cascade(int level, uint64_t tick);
+    void expire_slot(int slot, std::vector<Order*>& expired);
+};
+
+}
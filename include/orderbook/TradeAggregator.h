@@ -0,0 +1,87 @@
+#pragma once
+#include <cstdint>
+#include "../common/FixedPoint.h"
+#include "../common/SpscRing.h"
+
+namespace trading {
+
+enum class BarType : uint8_t {
+    TIME,
+    VOLUME
+};
+
+// One completed bar. Prices are Price raw values; notional is the sum of
+// raw price * volume; vwap() truncates to the raw tick.
+struct Bar {
+    BarType type = BarType::TIME;
+    uint64_t start_ns = 0;      // bucket start for time bars, first fill for volume bars
+    uint64_t end_ns = 0;        // bucket end (exclusive) for time bars, last fill for volume bars
+    int64_t open = 0;
+    int64_t high = 0;
+    int64_t low = 0;
+    int64_t close = 0;
+    int64_t volume = 0;
+    int64_t notional = 0;
+    uint32_t trade_count = 0;
+
+    Price vwap() const { return Price::fromRaw(volume > 0 ? notional / volume : 0); }
+};
+
+struct TradeAggregatorConfig {
+    uint64_t time_bar_ns = 60'000'000'000ULL;   // 0 disables time bars
+    int64_t volume_bar_size = 0;                // 0 disables volume bars
+    size_t ring_capacity = 4096;                // completed bars awaiting the consumer
+};
+
+// Running VWAP and OHLC bars fed fill-by-fill from the matching loop.
+//
+// on_fill() is O(1) integer arithmetic: it folds the fill into the session totals
+// and the open time and volume bars, and publishes a bar to the SPSC ring when
+// it completes. A fill that crosses volume bar boundaries is split across them.
+// Time buckets are aligned to multiples of time_bar_ns and only published once
+// they hold a trade; a bucket closes on the first fill after it ends or on flush().
+// Everything except pop_bar() belongs to the matching thread.
+//
+// Notional is kept in int64: about 9e18 raw price * volume per bar and session.
+class TradeAggregator {
+public:
+    explicit TradeAggregator(const TradeAggregatorConfig& config = TradeAggregatorConfig());
+
+    TradeAggregator(const TradeAggregator&) = delete;
+    TradeAggregator& operator=(const TradeAggregator&) = delete;
+
+    void on_fill(const Price& price, int volume, uint64_t timestamp_ns);
+
+    // Publishes the open bars as they stand, e.g. at session end
+    void flush();
+
+    // Consumer side
+    bool pop_bar(Bar& bar) { return ring_.try_pop(bar); }
+
+    // Session totals
+    Price vwap() const { return Price::fromRaw(session_volume_ > 0 ? session_notional_ / session_volume_ : 0); }
+    int64_t session_volume() const { return session_volume_; }
+    uint64_t session_trade_count() const { return session_trades_; }
+
+    const Bar& current_time_bar() const { return time_bar_; }
+    const Bar& current_volume_bar() const { return volume_bar_; }
+    uint64_t bars_dropped() const { return dropped_; }     // ring was full
+
+private:
+    TradeAggregatorConfig config_;
+    concurrency::SpscRing<Bar> ring_;
+
+    Bar time_bar_;
+    Bar volume_bar_;
+
+    int64_t session_notional_ = 0;
+    int64_t session_volume_ = 0;
+    uint64_t session_trades_ = 0;
+    uint64_t dropped_ = 0;
+
+    static void open_bar(Bar& bar, BarType type, int64_t price, uint64_t start_ns, uint64_t end_ns);
+    static void add_fill(Bar& bar, int64_t price, int64_t volume);
+    void publish(Bar& bar);
+};
+
+}
@@ -0,0 +1,168 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+#include "../io/EventRecord.h"
+#include "../orderbook/OrderbookTypes.h"
+
+namespace trading {
+namespace sim {
+
+enum class ArrivalProcess {
+    POISSON,    // constant intensity base_rate
+    HAWKES      // self-exciting: each event adds a decaying jump to the intensity
+};
+
+struct OrderFlowConfig {
+    uint64_t seed = 1;
+    uint64_t start_time_ns = 0;             // timestamp of the first arrival
+
+    // Arrivals, in events per second. For HAWKES base_rate is the background
+    // intensity; each event adds branching_ratio * hawkes_decay, decaying at
+    // hawkes_decay per second (branching_ratio < 1 keeps the process stationary).
+    ArrivalProcess arrivals = ArrivalProcess::POISSON;
+    double base_rate = 100000.0;
+    double branching_ratio = 0.7;
+    double hawkes_decay = 1000.0;
+
+    // Command mix, relative weights. Aggressive orders are IOC limits through the touch.
+    double add_weight = 0.45;
+    double cancel_weight = 0.40;
+    double modify_weight = 0.10;
+    double aggressive_weight = 0.05;
+
+    // Prices, relative to the book's mid. Passive orders rest a geometric number of
+    // ticks (mean passive_mean_ticks) behind the mid; aggressive orders reach
+    // 0..aggressive_max_ticks through it.
+    Price tick_size = Price::fromRaw(100);
+    Price initial_mid = Price::fromRaw(1000000);    // used until the book is two-sided
+    double passive_mean_ticks = 4.0;
+    int aggressive_max_ticks = 3;
+
+    int min_volume = 1;
+    int max_volume = 500;
+
+    // Participants P1..Pn with Zipf(participant_skew) activity
+    int participants = 100;
+    double participant_skew = 1.0;
+
+    int first_order_id = 1;
+    size_t buffer_capacity = 1 << 16;       // commands per batch
+    size_t max_live_orders = 1 << 20;       // adds beyond this become cancels
+};
+
+// Synthetic order flow for load testing.
+//
+// Commands are written as journal EventRecords (see io/Journal.h) into a buffer
+// allocated once up front, so a batch can be applied with ReplayVerifier::apply
+// and a recorded run replayed with io::read_journal. All randomness comes from a
+// seeded mt19937_64 with hand-rolled distributions, so a seed gives the same
+// flow on every platform as long as the book reacts the same way.
+//
+// Usage: next_batch(book, n), apply the returned records, repeat. Prices are
+// drawn around the book's mid at the start of each batch, and cancel/modify
+// targets are drawn from the generator's live orders, dropping those the book no
+// longer holds (filled or expired).
+class OrderFlowGenerator {
+public:
+    explicit OrderFlowGenerator(const OrderFlowConfig& config = OrderFlowConfig());
+
+    // Appends every subsequent batch to a journal file; throws std::system_error
+    // if it cannot be opened
+    void record_to(const std::string& path);
+
+    template <typename Book>
+    size_t next_batch(const Book& book, size_t count) {
+        begin_batch(book.get_mid_price());
+        if (count > buffer_.size()) {
+            count = buffer_.size();
+        }
+
+        for (size_t i = 0; i < count; ++i) {
+            Action action = draw_action();
+            size_t target = NO_TARGET;
+            if (action == Action::CANCEL || action == Action::MODIFY) {
+                while (!live_.empty()) {
+                    size_t k = draw_below(live_.size());
+                    int id = live_[k].order_id;
+                    if (id >= batch_first_id_ || book.has_order(id)) {
+                        target = k;
+                        break;
+                    }
+                    drop_live(k);
+                }
+                if (target == NO_TARGET) {
+                    action = Action::ADD;
+                }
+            }
+            emit(buffer_[i], action, target);
+        }
+
+        batch_size_ = count;
+        end_batch();
+        return count;
+    }
+
+    const io::EventRecord* data() const { return buffer_.data(); }
+    size_t size() const { return batch_size_; }
+    const io::EventRecord& operator[](size_t i) const { return buffer_[i]; }
+
+    uint64_t commands_generated() const { return sequence_; }
+    size_t live_orders() const { return live_.size(); }
+    uint64_t current_time_ns() const { return time_ns_; }
+
+private:
+    enum class Action { ADD, CANCEL, MODIFY, AGGRESSIVE };
+    static constexpr size_t NO_TARGET = SIZE_MAX;
+
+    struct LiveOrder {
+        int order_id;
+        Side side;
+    };
+
+    OrderFlowConfig config_;
+    std::mt19937_64 rng_;
+    std::vector<io::EventRecord> buffer_;
+    size_t batch_size_ = 0;
+
+    std::vector<LiveOrder> live_;
+    int next_order_id_;
+    int batch_first_id_;
+    uint64_t sequence_ = 0;
+
+    // Arrival clock
+    double time_s_ = 0.0;
+    uint64_t time_ns_;
+    double hawkes_excess_ = 0.0;    // intensity above base_rate at time_s_
+
+    // Cumulative action weights and participant activity
+    std::array<double, 4> action_cdf_{};
+    std::vector<double> participant_cdf_;
+    std::vector<std::array<char, 16>> client_names_;
+
+    double passive_log_q_ = 0.0;    // log(1 - p) of the passive depth distribution
+    int64_t mid_ticks_x2_;          // 2 * mid / tick, so half-tick mids stay exact
+    std::ofstream output_;
+
+    double draw_uniform();
+    size_t draw_below(size_t n);
+    double draw_exponential(double rate);
+    int draw_passive_depth();
+    Action draw_action();
+    int draw_volume();
+    size_t draw_participant();
+    void advance_clock();
+
+    void begin_batch(const Price& mid);
+    void end_batch();
+    void drop_live(size_t index);
+    int64_t passive_price(Side side);
+    int64_t aggressive_price(Side side);
+    void emit(io::EventRecord& record, Action action, size_t target);
+};
+
+}
+}
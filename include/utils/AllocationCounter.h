@@ -0,0 +1,80 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+namespace trading {
+namespace metrics {
+
+// Process-wide count of global operator new calls, for allocation audits.
+//
+// Counting needs the replacement allocation functions below: define
+// ORDERBOOK_ALLOCATION_HOOKS before including this header in exactly one
+// source file of the executable (never in the library). Without them the
+// count stays at zero and hooks_installed() is false.
+inline std::atomic<uint64_t> allocation_count{0};
+inline std::atomic<bool> allocation_hooks{false};
+
+inline uint64_t allocations() { return allocation_count.load(std::memory_order_relaxed); }
+inline bool hooks_installed() { return allocation_hooks.load(std::memory_order_relaxed); }
+
+// Allocations since construction
+class AllocationScope {
+public:
+    AllocationScope() : start_(allocations()) {}
+    uint64_t count() const { return allocations() - start_; }
+
+private:
+    uint64_t start_;
+};
+
+}
+}
+
+#ifdef ORDERBOOK_ALLOCATION_HOOKS
+
+namespace trading {
+namespace metrics {
+namespace detail {
+
+inline void* counted_alloc(std::size_t size, std::size_t alignment) {
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    if (size == 0) {
+        size = 1;
+    }
+    void* p = alignment > alignof(std::max_align_t)
+        ? std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment)
+        : std::malloc(size);
+    if (!p) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+inline const bool hooks_registered = (allocation_hooks.store(true), true);
+
+}
+}
+}
+
+void* operator new(std::size_t size) { return trading::metrics::detail::counted_alloc(size, 0); }
+void* operator new[](std::size_t size) { return trading::metrics::detail::counted_alloc(size, 0); }
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    return trading::metrics::detail::counted_alloc(size, static_cast<std::size_t>(alignment));
+}
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    return trading::metrics::detail::counted_alloc(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+
+#endif
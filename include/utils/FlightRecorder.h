@@ -0,0 +1,137 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <vector>
+#include "TscClock.h"
+
+// Flight-recorder tracing of book events; off by default, enabled with the
+// CMake option of the same name. When off ORDERBOOK_TRACE compiles away.
+#ifndef ORDERBOOK_FLIGHT_RECORDER
+#define ORDERBOOK_FLIGHT_RECORDER 0
+#endif
+
+// Records per thread, a power of two
+#ifndef ORDERBOOK_FLIGHT_RECORDER_CAPACITY
+#define ORDERBOOK_FLIGHT_RECORDER_CAPACITY 65536
+#endif
+
+namespace trading {
+namespace trace {
+
+enum class TraceEvent : uint8_t {
+    NONE = 0,
+    PLACE,          // order entered: id, limit price, volume, side
+    CANCEL,         // id
+    MODIFY,         // id, new price, new volume
+    TRADE,          // aggressor id, price, volume, side; aux = resting id, 0 for a level sweep
+    LEVEL_CREATE,   // price, side
+    LEVEL_REMOVE,   // price, side
+    POOL_GROW       // volume = objects per block, aux = blocks after growth
+};
+
+const char* to_string(TraceEvent event);
+
+// One compact record; half a cache line
+struct TraceRecord {
+    uint64_t tsc;
+    int64_t price;          // Price::raw_value()
+    int32_t order_id;
+    int32_t volume;
+    int32_t aux;
+    TraceEvent event;
+    uint8_t side;           // 0 = buy, 1 = sell
+    uint16_t reserved;
+};
+
+static_assert(sizeof(TraceRecord) == 32, "TraceRecord must stay 32 bytes");
+
+// Per-thread ring of the most recent TraceRecords.
+//
+// Each thread records into its own ring (local()), so recording is a TSC read
+// and a 32-byte store with no atomics or locks. Rings register themselves so
+// dump_all() - and the crash handler - can write every thread's history to one
+// file for decode_trace(). Calling local() once at thread start moves ring
+// allocation and TSC calibration off the hot path.
+class FlightRecorder {
+public:
+    static constexpr size_t CAPACITY = ORDERBOOK_FLIGHT_RECORDER_CAPACITY;
+    static_assert((CAPACITY & (CAPACITY - 1)) == 0, "capacity must be a power of two");
+
+    static FlightRecorder& local() {
+        static thread_local FlightRecorder recorder;
+        return recorder;
+    }
+
+    void record(TraceEvent event, int order_id, int64_t price, int volume, int aux, uint8_t side) {
+        TraceRecord& r = records_[written_++ & (CAPACITY - 1)];
+        r.tsc = metrics::TscClock::now();
+        r.price = price;
+        r.order_id = order_id;
+        r.volume = volume;
+        r.aux = aux;
+        r.event = event;
+        r.side = side;
+        r.reserved = 0;
+    }
+
+    uint64_t written() const { return written_; }
+    uint32_t thread_index() const { return thread_index_; }
+    void clear() { written_ = 0; }
+
+    // Oldest first, at most CAPACITY records
+    std::vector<TraceRecord> snapshot() const;
+
+    // Writes every live thread's ring to `path`; throws std::system_error on failure
+    static void dump_all(const std::string& path);
+
+    // On SIGSEGV, SIGBUS, SIGILL, SIGFPE or SIGABRT, writes every ring to `path`
+    // with async-signal-safe calls and re-raises the signal. A ring being
+    // written by another thread at that moment may end in a torn record.
+    static void install_crash_handler(const std::string& path);
+
+    FlightRecorder(const FlightRecorder&) = delete;
+    FlightRecorder& operator=(const FlightRecorder&) = delete;
+    ~FlightRecorder();
+
+private:
+    FlightRecorder();
+
+    std::unique_ptr<TraceRecord[]> records_;
+    uint64_t written_ = 0;
+    uint32_t thread_index_ = 0;
+
+    friend struct RingWriter;
+};
+
+// Offline side: a dump decoded into one timeline across threads
+struct DecodedRecord {
+    uint32_t thread_index;
+    TraceRecord record;
+};
+
+struct DecodedTrace {
+    double ticks_per_ns = 1.0;
+    uint64_t records_lost = 0;          // overwritten before the dump
+    std::vector<DecodedRecord> records; // ordered by TSC
+};
+
+// Throws std::system_error if the file cannot be read, std::runtime_error if it
+// is not a trace dump
+DecodedTrace decode_trace(const std::string& path);
+
+// One line per record, times in nanoseconds relative to the first record
+void print_timeline(const DecodedTrace& trace, std::ostream& out);
+
+}
+}
+
+#if ORDERBOOK_FLIGHT_RECORDER
+#define ORDERBOOK_TRACE(event, order_id, price, volume, aux, side) \
+    ::trading::trace::FlightRecorder::local().record(::trading::trace::TraceEvent::event, \
+        (order_id), (price), (volume), (aux), (side))
+#else
+#define ORDERBOOK_TRACE(event, order_id, price, volume, aux, side) ((void)0)
+#endif
@@ -0,0 +1,121 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include "TscClock.h"
+
+namespace trading {
+namespace metrics {
+
+// Percentiles of one histogram, in nanoseconds
+struct LatencySummary {
+    uint64_t count = 0;
+    uint64_t min = 0;
+    uint64_t p50 = 0;
+    uint64_t p99 = 0;
+    uint64_t p999 = 0;
+    uint64_t max = 0;
+};
+
+// HDR-style log-linear histogram of TSC tick counts.
+//
+// Values below 2 * SUB_BUCKETS are counted exactly; above that each power of two
+// is split into SUB_BUCKETS linear buckets, so any recorded value is reported
+// within 1 / SUB_BUCKETS (~3%) of itself across the full 64-bit range. Buckets are
+// a fixed array - record() is a bit scan and an increment and never allocates.
+class LatencyHistogram {
+public:
+    static constexpr int SUB_BUCKET_BITS = 5;
+    static constexpr uint64_t SUB_BUCKETS = 1ULL << SUB_BUCKET_BITS;
+    static constexpr size_t BUCKET_COUNT = (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+    void record(uint64_t ticks) {
+        counts_[bucket_index(ticks)]++;
+        count_++;
+        if (ticks < min_) min_ = ticks;
+        if (ticks > max_) max_ = ticks;
+    }
+
+    uint64_t count() const { return count_; }
+    uint64_t min() const { return count_ ? min_ : 0; }
+    uint64_t max() const { return max_; }
+
+    // Highest value equivalent to the sample at `percentile` (0-100), in ticks
+    uint64_t value_at_percentile(double percentile) const {
+        if (count_ == 0) {
+            return 0;
+        }
+        double exact = percentile / 100.0 * static_cast<double>(count_);
+        uint64_t rank = static_cast<uint64_t>(exact);
+        if (static_cast<double>(rank) < exact) rank++;
+        if (rank < 1) rank = 1;
+        if (rank > count_) rank = count_;
+
+        uint64_t seen = 0;
+        for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+            seen += counts_[i];
+            if (seen >= rank) {
+                uint64_t upper = bucket_upper(i);
+                return upper < max_ ? upper : max_;
+            }
+        }
+        return max_;
+    }
+
+    LatencySummary summary() const {
+        LatencySummary s;
+        s.count = count_;
+        s.min = TscClock::to_ns(min());
+        s.p50 = TscClock::to_ns(value_at_percentile(50.0));
+        s.p99 = TscClock::to_ns(value_at_percentile(99.0));
+        s.p999 = TscClock::to_ns(value_at_percentile(99.9));
+        s.max = TscClock::to_ns(max_);
+        return s;
+    }
+
+    void reset() {
+        counts_.fill(0);
+        count_ = 0;
+        min_ = UINT64_MAX;
+        max_ = 0;
+    }
+
+    static size_t bucket_index(uint64_t value) {
+        if (value < 2 * SUB_BUCKETS) {
+            return static_cast<size_t>(value);
+        }
+        int shift = (63 - __builtin_clzll(value)) - SUB_BUCKET_BITS;
+        return static_cast<size_t>(shift + 1) * SUB_BUCKETS + ((value >> shift) - SUB_BUCKETS);
+    }
+
+    static uint64_t bucket_upper(size_t index) {
+        if (index < 2 * SUB_BUCKETS) {
+            return index;
+        }
+        int shift = static_cast<int>(index / SUB_BUCKETS) - 1;
+        uint64_t sub = index % SUB_BUCKETS + SUB_BUCKETS;
+        return ((sub + 1) << shift) - 1;
+    }
+
+private:
+    std::array<uint64_t, BUCKET_COUNT> counts_{};
+    uint64_t count_ = 0;
+    uint64_t min_ = UINT64_MAX;
+    uint64_t max_ = 0;
+};
+
+// Records the ticks between construction and destruction
+class ScopedLatency {
+public:
+    explicit ScopedLatency(LatencyHistogram& histogram) : histogram_(histogram), start_(TscClock::now()) {}
+    ~ScopedLatency() { histogram_.record(TscClock::now() - start_); }
+
+    ScopedLatency(const ScopedLatency&) = delete;
+    ScopedLatency& operator=(const ScopedLatency&) = delete;
+
+private:
+    LatencyHistogram& histogram_;
+    uint64_t start_;
+};
+
+}
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace trading {
+namespace metrics {
+
+enum class PerfEvent {
+    CYCLES,
+    INSTRUCTIONS,
+    L1D_MISSES,
+    LLC_MISSES,
+    BRANCH_MISSES,
+    DTLB_MISSES,
+    COUNT
+};
+
+constexpr size_t PERF_EVENT_COUNT = static_cast<size_t>(PerfEvent::COUNT);
+
+struct PerfSample {
+    std::array<uint64_t, PERF_EVENT_COUNT> values{};
+    uint64_t time_enabled = 0;
+    uint64_t time_running = 0;
+};
+
+// Hardware counters of the calling thread, read through perf_event_open as one
+// group so all events cover the same instructions. User space only.
+//
+// Events the CPU or kernel refuses are left out; if the group leader (cycles)
+// cannot be opened - no PMU, perf_event_paranoid, seccomp, non-Linux - the group
+// is unavailable and read() returns zeros. Each read() is one syscall.
+class PerfCounterGroup {
+public:
+    PerfCounterGroup();
+    ~PerfCounterGroup();
+
+    PerfCounterGroup(const PerfCounterGroup&) = delete;
+    PerfCounterGroup& operator=(const PerfCounterGroup&) = delete;
+
+    bool available() const { return fds_[0] >= 0; }
+    bool has(PerfEvent event) const { return fds_[static_cast<size_t>(event)] >= 0; }
+
+    void read(PerfSample& sample) const;
+
+private:
+    std::array<int, PERF_EVENT_COUNT> fds_;
+};
+
+}
+}
@@ -0,0 +1,38 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define ORDERBOOK_HAS_TSC 1
+#else
+#define ORDERBOOK_HAS_TSC 0
+#endif
+
+namespace trading {
+namespace metrics {
+
+// Cycle counter for latency measurement. Reads the TSC where available (a few
+// cycles, no kernel entry) and falls back to steady_clock nanoseconds elsewhere.
+// Tick-to-nanosecond conversion uses a rate calibrated once per process.
+class TscClock {
+public:
+    static uint64_t now() {
+#if ORDERBOOK_HAS_TSC
+        return __rdtsc();
+#else
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+    }
+
+    // Calibrated on first use against steady_clock (~10ms)
+    static double ticks_per_ns();
+
+    static uint64_t to_ns(uint64_t ticks) {
+        return static_cast<uint64_t>(static_cast<double>(ticks) / ticks_per_ns());
+    }
+};
+
+}
+}
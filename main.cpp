@@ -1,7 +1,8 @@
 #include <iostream>
-#include <random>
 #include "include/orderbook/Orderbook.h"
 #include "include/orderbook/Order.h"
+#include "include/orderbook/ReplayVerifier.h"
+#include "include/sim/OrderFlowGenerator.h"
 #include "include/utils/Benchmark.h"
 #include "include/common/FixedPoint.h"
 
@@ -11,32 +12,23 @@ int main() {
 	Orderbook orderbook;
 	std::vector<TradeInfo> trades;
 
-	std::random_device rd;
-	std::mt19937 gen(42);
-	std::uniform_real_distribution<> price_dist(99.0, 101.0);
-	std::uniform_int_distribution<> volume_dist(10, 500);
-	std::uniform_int_distribution<> side_dist(0, 1);
-
-	std::vector<std::string> clients = {
-		"Goldman Sachs", "JPMorgan", "Morgan Stanley",
-		"Bridgewater", "DE Shaw", "Millennium", "Point72", 
-		"Balyasny", "Susquehanna", "IMC", "Flow Traders"
-	};
-
 	std::cout << "=== Order Book ===\n\n";
 
 	{
-		Benchmark benchmark;
-
-		// Place 500000 orders around mid-price of 100
-		for (int i = 0; i < 50000; i++) {
-			std::string client = clients[i % clients.size()];
-			double price = price_dist(gen);
-			int volume = volume_dist(gen);
-			Side side = side_dist(gen) == 0 ? Side::BUY : Side::SELL;
+		// 50000 commands of synthetic flow around a mid of 100, generated in
+		// batches priced off the book's current mid
+		sim::OrderFlowConfig flow_config;
+		flow_config.seed = 42;
+		flow_config.initial_mid = Price("100.0000");
+		flow_config.buffer_capacity = 1000;
+		sim::OrderFlowGenerator generator(flow_config);
 
-			Order order(client, price, volume, side);
-			orderbook.place_order(order, trades);
+		Benchmark benchmark;
+		for (int batch = 0; batch < 50; batch++) {
+			size_t n = generator.next_batch(orderbook, flow_config.buffer_capacity);
+			for (size_t i = 0; i < n; i++) {
+				ReplayVerifier::apply(orderbook, generator[i], trades);
+			}
 		}
 	}
 
@@ -48,6 +40,14 @@ int main() {
 	std::cout << "Best ask: " << orderbook.get_best_ask().to_string() << "\n";
 	std::cout << "Mid price: " << orderbook.get_mid_price().to_string() << "\n";
 
+	BookMemoryStats memory = orderbook.memory_stats();
+	for (const auto& [name, pool] : {std::make_pair("Order pool", memory.orders),
+	                                 std::make_pair("Level pool", memory.levels)}) {
+		std::cout << name << ": " << pool.used << " used of " << pool.capacity << " in " << pool.blocks
+		          << " blocks (" << pool.bytes() / 1024 << " KiB), high water " << pool.high_water
+		          << ", " << static_cast<int>(pool.fragmentation() * 100) << "% fragmented\n";
+	}
+
 	if (!trades.empty()) {
 		int total_volume = 0;
 		for (const auto& trade : trades) {
@@ -65,7 +65,7 @@ int main() {
 	// Place a large buy order that will cross the spread
 	std::cout << "\nPlacing aggressive buy order (500 @ 100.50)...\n";
 	trades.clear();
-	Order aggressive_buy("Aggressive Trader", 100.50, 500, Side::BUY);
+	Order aggressive_buy("Aggressive Trader", Price("100.50"), 500, Side::BUY);
 	auto result = orderbook.place_order(aggressive_buy, trades);
 	std::cout << "Result: " << static_cast<int>(result) << "\n";
 	std::cout << "Trades executed: " << trades.size() << "\n";
@@ -79,7 +79,7 @@ int main() {
 	// Place a passive order that rests in the book
 	std::cout << "\nPlacing passive sell order (100 @ 100.80)...\n";
 	trades.clear();
-	Order passive_sell("Market Maker", 100.80, 100, Side::SELL);
+	Order passive_sell("Market Maker", Price("100.80"), 100, Side::SELL);
 	result = orderbook.place_order(passive_sell, trades);
 	std::cout << "Result: " << static_cast<int>(result) << "\n";
 	std::cout << "Order resting in book\n";
@@ -0,0 +1,566 @@
+#include "../../include/io/AsyncFileWriter.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#define ORDERBOOK_HAS_IO_URING 1
+#else
+#define ORDERBOOK_HAS_IO_URING 0
+#endif
+
+namespace trading {
+namespace io {
+
+// Buffer bookkeeping shared by both backends. Runs entirely on the writer thread.
+class WriterBackendImpl {
+public:
+    std::atomic<uint64_t> bytes_written{0};
+    std::atomic<uint64_t> submissions{0};
+    std::atomic<uint64_t> io_errors{0};
+
+    WriterBackendImpl(int fd, uint64_t offset, const AsyncWriterConfig& config) :
+        fd_(fd),
+        file_offset_(offset),
+        buffer_size_(config.buffer_size)
+    {
+        for (size_t i = 0; i < config.buffer_count; ++i) {
+            void* mem = std::aligned_alloc(4096, buffer_size_);
+            if (!mem) throw std::bad_alloc();
+            buffers_.push_back(static_cast<char*>(mem));
+            free_buffers_.push_back(config.buffer_count - 1 - i);
+        }
+    }
+
+    virtual ~WriterBackendImpl() {
+        for (char* buffer : buffers_) {
+            std::free(buffer);
+        }
+    }
+
+    // Returns a buffer the writer thread may fill, waiting for I/O if all are in flight
+    char* acquire_buffer(size_t& index) {
+        while (free_buffers_.empty()) {
+            flush();
+            if (free_buffers_.empty()) {
+                wait_for_completion();
+            }
+        }
+        index = free_buffers_.back();
+        free_buffers_.pop_back();
+        return buffers_[index];
+    }
+
+    void release_buffer(size_t index) {
+        free_buffers_.push_back(index);
+    }
+
+    // Queues a filled buffer; it is handed to the kernel on the next flush()
+    virtual void submit(size_t index, size_t length) = 0;
+    virtual void flush() = 0;
+    virtual void wait_for_completion() = 0;
+
+    void drain() {
+        flush();
+        while (free_buffers_.size() < buffers_.size()) {
+            wait_for_completion();
+        }
+    }
+
+protected:
+    int fd_;
+    uint64_t file_offset_;
+    size_t buffer_size_;
+    std::vector<char*> buffers_;
+    std::vector<size_t> free_buffers_;
+};
+
+// Fallback: gathers every queued buffer into a single pwritev call
+class PwritevBackend : public WriterBackendImpl {
+public:
+    using WriterBackendImpl::WriterBackendImpl;
+
+    void submit(size_t index, size_t length) override {
+        pending_.push_back({index, length});
+    }
+
+    void flush() override {
+        if (pending_.empty()) return;
+
+        iovecs_.clear();
+        size_t total = 0;
+        for (const auto& p : pending_) {
+            iovecs_.push_back({buffers_[p.first], p.second});
+            total += p.second;
+        }
+
+        // Loop to cover short writes by advancing through the iovec array
+        size_t done = 0;
+        size_t first = 0;
+        while (done < total) {
+            ssize_t n = ::pwritev(fd_, iovecs_.data() + first, static_cast<int>(iovecs_.size() - first),
+                                  static_cast<off_t>(file_offset_ + done));
+            submissions.fetch_add(1, std::memory_order_relaxed);
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                io_errors.fetch_add(1, std::memory_order_relaxed);
+                break;
+            }
+            done += static_cast<size_t>(n);
+            while (first < iovecs_.size() && static_cast<size_t>(n) >= iovecs_[first].iov_len) {
+                n -= static_cast<ssize_t>(iovecs_[first].iov_len);
+                first++;
+            }
+            if (first < iovecs_.size()) {
+                iovecs_[first].iov_base = static_cast<char*>(iovecs_[first].iov_base) + n;
+                iovecs_[first].iov_len -= static_cast<size_t>(n);
+            }
+        }
+
+        file_offset_ += total;
+        bytes_written.fetch_add(done, std::memory_order_relaxed);
+        for (const auto& p : pending_) {
+            free_buffers_.push_back(p.first);
+        }
+        pending_.clear();
+    }
+
+    void wait_for_completion() override {
+        // pwritev completes synchronously inside flush()
+    }
+
+private:
+    std::vector<std::pair<size_t, size_t>> pending_;
+    std::vector<iovec> iovecs_;
+};
+
+#if ORDERBOOK_HAS_IO_URING
+
+// io_uring backend driven through raw syscalls so no liburing dependency is needed.
+// Buffers are registered once and written with IORING_OP_WRITE_FIXED.
+class IoUringBackend : public WriterBackendImpl {
+public:
+    IoUringBackend(int fd, uint64_t offset, const AsyncWriterConfig& config) :
+        WriterBackendImpl(fd, offset, config),
+        inflight_(config.buffer_count)
+    {}
+
+    ~IoUringBackend() override {
+        if (sqes_) ::munmap(sqes_, sqes_len_);
+        if (cq_ptr_ && cq_ptr_ != sq_ptr_) ::munmap(cq_ptr_, cq_len_);
+        if (sq_ptr_) ::munmap(sq_ptr_, sq_len_);
+        if (ring_fd_ >= 0) ::close(ring_fd_);
+    }
+
+    // Returns false when the kernel or sandbox does not allow io_uring
+    bool init() {
+        unsigned entries = 1;
+        while (entries < buffers_.size() * 2) entries <<= 1;
+
+        io_uring_params params;
+        std::memset(&params, 0, sizeof(params));
+        ring_fd_ = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+        if (ring_fd_ < 0) return false;
+
+        sq_len_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cq_len_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+        if (single_mmap) {
+            sq_len_ = cq_len_ = std::max(sq_len_, cq_len_);
+        }
+
+        sq_ptr_ = ::mmap(nullptr, sq_len_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                         ring_fd_, IORING_OFF_SQ_RING);
+        if (sq_ptr_ == MAP_FAILED) { sq_ptr_ = nullptr; return false; }
+
+        if (single_mmap) {
+            cq_ptr_ = sq_ptr_;
+        } else {
+            cq_ptr_ = ::mmap(nullptr, cq_len_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                             ring_fd_, IORING_OFF_CQ_RING);
+            if (cq_ptr_ == MAP_FAILED) { cq_ptr_ = nullptr; return false; }
+        }
+
+        sqes_len_ = params.sq_entries * sizeof(io_uring_sqe);
+        void* sqes = ::mmap(nullptr, sqes_len_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                            ring_fd_, IORING_OFF_SQES);
+        if (sqes == MAP_FAILED) return false;
+        sqes_ = static_cast<io_uring_sqe*>(sqes);
+
+        char* sq = static_cast<char*>(sq_ptr_);
+        sq_head_ = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+        sq_tail_ = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        sq_mask_ = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        sq_entries_ = params.sq_entries;
+        sq_array_ = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+
+        char* cq = static_cast<char*>(cq_ptr_);
+        cq_head_ = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        cq_tail_ = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        cq_mask_ = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        cqes_ = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+
+        std::vector<iovec> iov;
+        for (char* buffer : buffers_) {
+            iov.push_back({buffer, buffer_size_});
+        }
+        if (::syscall(__NR_io_uring_register, ring_fd_, IORING_REGISTER_BUFFERS,
+                      iov.data(), static_cast<unsigned>(iov.size())) < 0) {
+            return false;
+        }
+
+        return true;
+    }
+
+    void submit(size_t index, size_t length) override {
+        inflight_[index] = {file_offset_, length, 0};
+        file_offset_ += length;
+        queue_write(index);
+    }
+
+    void flush() override {
+        if (to_submit_ == 0) return;
+
+        while (to_submit_ > 0) {
+            long n = ::syscall(__NR_io_uring_enter, ring_fd_, to_submit_, 0, 0, nullptr, 0);
+            if (n < 0) {
+                if (errno == EINTR || errno == EAGAIN || errno == EBUSY) {
+                    reap();
+                    continue;
+                }
+                io_errors.fetch_add(1, std::memory_order_relaxed);
+                break;
+            }
+            submissions.fetch_add(1, std::memory_order_relaxed);
+            to_submit_ -= static_cast<unsigned>(n);
+        }
+        reap();
+    }
+
+    void wait_for_completion() override {
+        if (reap() > 0) return;
+        if (to_submit_ == 0 && free_buffers_.size() == buffers_.size()) return;
+
+        // Resubmissions queued by reap() go out together with the wait
+        long n = ::syscall(__NR_io_uring_enter, ring_fd_, to_submit_, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+        if (n > 0) {
+            submissions.fetch_add(1, std::memory_order_relaxed);
+            to_submit_ -= static_cast<unsigned>(n);
+        }
+        reap();
+    }
+
+private:
+    struct Inflight {
+        uint64_t offset;
+        size_t length;
+        size_t done;
+    };
+
+    int ring_fd_ = -1;
+    void* sq_ptr_ = nullptr;
+    void* cq_ptr_ = nullptr;
+    size_t sq_len_ = 0;
+    size_t cq_len_ = 0;
+    size_t sqes_len_ = 0;
+    io_uring_sqe* sqes_ = nullptr;
+    io_uring_cqe* cqes_ = nullptr;
+
+    unsigned* sq_head_ = nullptr;
+    unsigned* sq_tail_ = nullptr;
+    unsigned* sq_array_ = nullptr;
+    unsigned sq_mask_ = 0;
+    unsigned sq_entries_ = 0;
+    unsigned* cq_head_ = nullptr;
+    unsigned* cq_tail_ = nullptr;
+    unsigned cq_mask_ = 0;
+    unsigned to_submit_ = 0;
+
+    std::vector<Inflight> inflight_;
+
+    void queue_write(size_t index) {
+        unsigned tail = *sq_tail_;
+        while (tail - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE) >= sq_entries_) {
+            flush();
+            wait_for_completion();
+            tail = *sq_tail_;
+        }
+
+        const Inflight& w = inflight_[index];
+        unsigned slot = tail & sq_mask_;
+        io_uring_sqe* sqe = &sqes_[slot];
+        std::memset(sqe, 0, sizeof(*sqe));
+        sqe->opcode = IORING_OP_WRITE_FIXED;
+        sqe->fd = fd_;
+        sqe->addr = reinterpret_cast<uint64_t>(buffers_[index] + w.done);
+        sqe->len = static_cast<uint32_t>(w.length - w.done);
+        sqe->off = w.offset + w.done;
+        sqe->buf_index = static_cast<uint16_t>(index);
+        sqe->user_data = index;
+
+        sq_array_[slot] = slot;
+        __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+        to_submit_++;
+    }
+
+    // Consumes available completions; returns how many buffers became free
+    size_t reap() {
+        size_t released = 0;
+        unsigned head = *cq_head_;
+        while (head != __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE)) {
+            const io_uring_cqe& cqe = cqes_[head & cq_mask_];
+            size_t index = static_cast<size_t>(cqe.user_data);
+            int res = cqe.res;
+            head++;
+            __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+
+            Inflight& w = inflight_[index];
+            if (res == -EINTR || res == -EAGAIN) {
+                queue_write(index);
+                continue;
+            }
+            if (res < 0) {
+                io_errors.fetch_add(1, std::memory_order_relaxed);
+            } else {
+                w.done += static_cast<size_t>(res);
+                bytes_written.fetch_add(static_cast<uint64_t>(res), std::memory_order_relaxed);
+                if (res > 0 && w.done < w.length) {
+                    // Short write - resubmit the remainder
+                    queue_write(index);
+                    continue;
+                }
+            }
+
+            free_buffers_.push_back(index);
+            released++;
+        }
+        return released;
+    }
+};
+
+#endif
+
+namespace {
+
+uint64_t elapsed_ns(std::chrono::steady_clock::time_point start) {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start).count());
+}
+
+}
+
+AsyncFileWriter::AsyncFileWriter(const std::string& path, const AsyncWriterConfig& config) :
+    ring_(config.ring_capacity),
+    active_backend_(WriterBackend::PWRITEV)
+{
+    if (config.buffer_count == 0 || config.buffer_size < sizeof(EventRecord) ||
+        config.buffer_size % sizeof(EventRecord) != 0) {
+        throw std::invalid_argument("AsyncFileWriter: buffer_size must be a non-zero multiple of the record size");
+    }
+
+    int flags = O_WRONLY | O_CREAT | O_CLOEXEC | (config.truncate ? O_TRUNC : 0);
+    int fd = ::open(path.c_str(), flags, 0644);
+    if (fd < 0) {
+        throw std::system_error(errno, std::generic_category(), "AsyncFileWriter: cannot open " + path);
+    }
+
+    struct stat st;
+    uint64_t offset = (::fstat(fd, &st) == 0) ? static_cast<uint64_t>(st.st_size) : 0;
+    fd_ = fd;
+    sync_on_close_ = config.sync_on_close;
+
+#if ORDERBOOK_HAS_IO_URING
+    if (config.backend != WriterBackend::PWRITEV) {
+        auto uring = std::make_unique<IoUringBackend>(fd, offset, config);
+        if (uring->init()) {
+            impl_ = std::move(uring);
+            active_backend_ = WriterBackend::IO_URING;
+        }
+    }
+#endif
+
+    if (!impl_) {
+        if (config.backend == WriterBackend::IO_URING) {
+            ::close(fd);
+            throw std::runtime_error("AsyncFileWriter: io_uring is not available");
+        }
+        impl_ = std::make_unique<PwritevBackend>(fd, offset, config);
+    }
+
+    records_per_buffer_ = config.buffer_size / sizeof(EventRecord);
+    start_time_ = std::chrono::steady_clock::now();
+    writer_thread_ = std::thread(&AsyncFileWriter::run, this);
+}
+
+AsyncFileWriter::~AsyncFileWriter() {
+    close();
+}
+
+bool AsyncFileWriter::try_write(const EventRecord& record) {
+    auto start = std::chrono::steady_clock::now();
+    bool pushed = ring_.try_push(record);
+    if (!pushed) {
+        records_dropped_++;
+    }
+    record_latency(elapsed_ns(start));
+    return pushed;
+}
+
+void AsyncFileWriter::write(const EventRecord& record) {
+    auto start = std::chrono::steady_clock::now();
+    if (!ring_.try_push(record)) {
+        producer_stalls_++;
+        while (!ring_.try_push(record)) {
+            // spin - the writer thread is draining
+        }
+    }
+    record_latency(elapsed_ns(start));
+}
+
+void AsyncFileWriter::record_latency(uint64_t ns) {
+    size_t bucket = 0;
+    while (bucket + 1 < LATENCY_BUCKETS && (ns >> (bucket + 1)) != 0) {
+        bucket++;
+    }
+    latency_buckets_[bucket]++;
+    if (ns > producer_max_ns_) {
+        producer_max_ns_ = ns;
+    }
+}
+
+void AsyncFileWriter::run() {
+    size_t buffer_index = 0;
+    char* buffer = nullptr;
+    size_t filled = 0;
+    int idle_spins = 0;
+
+    while (true) {
+        if (!buffer) {
+            buffer = impl_->acquire_buffer(buffer_index);
+        }
+
+        EventRecord* records = reinterpret_cast<EventRecord*>(buffer);
+        size_t popped = ring_.pop_batch(records + filled, records_per_buffer_ - filled);
+        filled += popped;
+
+        if (filled == records_per_buffer_) {
+            impl_->submit(buffer_index, filled * sizeof(EventRecord));
+            buffer = nullptr;
+            filled = 0;
+            idle_spins = 0;
+            continue;
+        }
+
+        if (popped > 0) {
+            idle_spins = 0;
+            continue;
+        }
+
+        // Ring is empty: push out what we have in one batched submission
+        if (filled > 0) {
+            impl_->submit(buffer_index, filled * sizeof(EventRecord));
+            buffer = nullptr;
+            filled = 0;
+        }
+        impl_->flush();
+
+        if (stop_.load(std::memory_order_acquire) && ring_.empty()) {
+            if (buffer) {
+                impl_->release_buffer(buffer_index);
+            }
+            break;
+        }
+
+        if (++idle_spins > 64) {
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        } else {
+            std::this_thread::yield();
+        }
+    }
+
+    impl_->drain();
+}
+
+void AsyncFileWriter::close() {
+    if (closed_) return;
+    closed_ = true;
+
+    stop_.store(true, std::memory_order_release);
+    if (writer_thread_.joinable()) {
+        writer_thread_.join();
+    }
+    stop_time_ = std::chrono::steady_clock::now();
+
+    if (sync_on_close_) {
+        ::fsync(fd_);
+    }
+    final_bytes_written_ = impl_->bytes_written.load(std::memory_order_relaxed);
+    final_submissions_ = impl_->submissions.load(std::memory_order_relaxed);
+    final_io_errors_ = impl_->io_errors.load(std::memory_order_relaxed);
+    impl_.reset();
+    ::close(fd_);
+    fd_ = -1;
+}
+
+AsyncWriterStats AsyncFileWriter::stats() const {
+    AsyncWriterStats s;
+    s.backend = active_backend_;
+    s.records_dropped = records_dropped_;
+    s.producer_stalls = producer_stalls_;
+    s.producer_max_ns = producer_max_ns_;
+
+    if (impl_) {
+        s.bytes_written = impl_->bytes_written.load(std::memory_order_relaxed);
+        s.submissions = impl_->submissions.load(std::memory_order_relaxed);
+        s.io_errors = impl_->io_errors.load(std::memory_order_relaxed);
+    } else {
+        s.bytes_written = final_bytes_written_;
+        s.submissions = final_submissions_;
+        s.io_errors = final_io_errors_;
+    }
+    s.records_written = s.bytes_written / sizeof(EventRecord);
+
+    auto end = closed_ ? stop_time_ : std::chrono::steady_clock::now();
+    s.elapsed_seconds = std::chrono::duration<double>(end - start_time_).count();
+    if (s.elapsed_seconds > 0.0) {
+        s.megabytes_per_second = (s.bytes_written / (1024.0 * 1024.0)) / s.elapsed_seconds;
+    }
+
+    // Percentiles reported as the upper bound of the log2 bucket they fall into
+    uint64_t total = 0;
+    for (uint64_t count : latency_buckets_) total += count;
+
+    auto percentile = [&](double p) -> uint64_t {
+        if (total == 0) return 0;
+        uint64_t target = static_cast<uint64_t>(p * static_cast<double>(total));
+        if (target >= total) target = total - 1;
+        uint64_t seen = 0;
+        for (size_t i = 0; i < LATENCY_BUCKETS; ++i) {
+            seen += latency_buckets_[i];
+            if (seen > target) {
+                uint64_t upper = (uint64_t(2) << i) - 1;
+                return upper < producer_max_ns_ ? upper : producer_max_ns_;
+            }
+        }
+        return producer_max_ns_;
+    };
+
+    s.producer_p50_ns = percentile(0.50);
+    s.producer_p99_ns = percentile(0.99);
+    s.producer_p999_ns = percentile(0.999);
+    return s;
+}
+
+}
+}
@@ -0,0 +1,229 @@
+#include "../../include/io/Journal.h"
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+
+namespace trading {
+namespace io {
+
+namespace {
+
+uint64_t to_ns(std::chrono::system_clock::time_point tp) {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(tp.time_since_epoch()).count());
+}
+
+std::chrono::system_clock::time_point to_time_point(uint64_t ns) {
+    return std::chrono::system_clock::time_point{
+        std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds(ns))};
+}
+
+EventRecord blank_record(uint64_t sequence, EventType type) {
+    EventRecord record;
+    std::memset(&record, 0, sizeof(record));
+    record.sequence = sequence;
+    record.type = type;
+    return record;
+}
+
+}
+
+std::vector<EventRecord> make_config_records(uint64_t sequence, const BookConfig& config) {
+    std::vector<EventRecord> records;
+    EventRecord header = blank_record(sequence, EventType::BOOK_CONFIG);
+    header.order_type = static_cast<uint8_t>(config.policy);
+    header.aux = config.lmm_participant_id;
+    header.volume = config.lmm_percent;
+    header.side = static_cast<uint8_t>(config.stp_mode);
+    header.timestamp_ns = to_ns(config.session_end);
+    header.order_id = static_cast<int32_t>(config.tick_bands.size());
+    records.push_back(header);
+
+    for (const TickTable::Band& band : config.tick_bands) {
+        EventRecord record = blank_record(sequence, EventType::TICK_BAND);
+        record.price = band.from.raw_value();
+        record.payload = static_cast<uint64_t>(band.tick.raw_value());
+        records.push_back(record);
+    }
+    return records;
+}
+
+size_t read_config(const std::vector<EventRecord>& journal, BookConfig& config) {
+    if (journal.empty() || journal.front().type != EventType::BOOK_CONFIG) {
+        return 0;
+    }
+
+    const EventRecord& header = journal.front();
+    if (header.order_type > static_cast<uint8_t>(BookPolicy::FIFO_LMM)) {
+        throw std::runtime_error("read_config: unknown matching policy " + std::to_string(header.order_type));
+    }
+    if (header.side > static_cast<uint8_t>(SelfTradePrevention::DECREMENT_AND_CANCEL)) {
+        throw std::runtime_error("read_config: unknown self-trade prevention mode " + std::to_string(header.side));
+    }
+    size_t bands = header.order_id > 0 ? static_cast<size_t>(header.order_id) : 0;
+    if (journal.size() < 1 + bands) {
+        throw std::runtime_error("read_config: header truncated");
+    }
+
+    BookConfig decoded;
+    decoded.policy = static_cast<BookPolicy>(header.order_type);
+    decoded.lmm_participant_id = header.aux;
+    decoded.lmm_percent = header.volume;
+    decoded.stp_mode = static_cast<SelfTradePrevention>(header.side);
+    decoded.session_end = to_time_point(header.timestamp_ns);
+    decoded.tick_bands.clear();
+    for (size_t i = 1; i <= bands; ++i) {
+        if (journal[i].type != EventType::TICK_BAND) {
+            throw std::runtime_error("read_config: header truncated");
+        }
+        decoded.tick_bands.push_back(TickTable::Band{Price::fromRaw(journal[i].price),
+                                                     Price::fromRaw(static_cast<int64_t>(journal[i].payload))});
+    }
+
+    config = std::move(decoded);
+    return 1 + bands;
+}
+
+EventRecord make_place_record(uint64_t sequence, const Order& order, bool level_fills) {
+    EventRecord record = blank_record(sequence, EventType::ORDER_PLACED);
+    record.timestamp_ns = to_ns(order.get_timestamp());
+    record.price = order.get_price().raw_value();
+    record.order_id = order.get_order_id();
+    record.volume = order.get_volume();
+    record.side = order.get_side() == Side::BUY ? 0 : 1;
+    record.flags = static_cast<uint8_t>(order.get_time_in_force());
+    if (level_fills) {
+        record.flags |= PLACE_WITH_LEVEL_FILLS;
+    }
+    if (needs_extension_record(order)) {
+        record.flags |= PLACE_HAS_EXTENSION;
+    }
+    record.order_type = static_cast<uint8_t>(order.get_order_type());
+    record.aux = order.get_protection_ticks();
+    record.payload = static_cast<uint64_t>(order.get_peak_size());
+
+    record.set_client(order.get_client().data(), order.get_client().size());
+    return record;
+}
+
+bool needs_extension_record(const Order& order) {
+    return order.get_stop_price().raw_value() != 0 ||
+           order.get_expire_time().time_since_epoch().count() != 0 ||
+           order.get_participant_id() != 0;
+}
+
+EventRecord make_place_extension_record(uint64_t sequence, const Order& order) {
+    EventRecord record = blank_record(sequence, EventType::ORDER_EXTENSION);
+    record.order_id = order.get_order_id();
+    record.price = order.get_stop_price().raw_value();
+    record.timestamp_ns = to_ns(order.get_expire_time());
+    record.aux = order.get_participant_id();
+    return record;
+}
+
+EventRecord make_cancel_record(uint64_t sequence, int order_id) {
+    EventRecord record = blank_record(sequence, EventType::ORDER_CANCELLED);
+    record.order_id = order_id;
+    return record;
+}
+
+EventRecord make_modify_record(uint64_t sequence, int order_id, const Price& new_price, int new_volume) {
+    EventRecord record = blank_record(sequence, EventType::ORDER_MODIFIED);
+    record.order_id = order_id;
+    record.price = new_price.raw_value();
+    record.volume = new_volume;
+    return record;
+}
+
+EventRecord make_mass_cancel_record(uint64_t sequence, int participant_id, const MassCancelFilter& filter) {
+    EventRecord record = blank_record(sequence, EventType::MASS_CANCEL);
+    record.aux = participant_id;
+    record.flags = (filter.include_buys ? MASS_CANCEL_BUYS : 0) | (filter.include_sells ? MASS_CANCEL_SELLS : 0);
+    record.price = filter.min_price.raw_value();
+    record.payload = static_cast<uint64_t>(filter.max_price.raw_value());
+    return record;
+}
+
+EventRecord make_auction_record(uint64_t sequence) {
+    return blank_record(sequence, EventType::AUCTION_STARTED);
+}
+
+EventRecord make_uncross_record(uint64_t sequence, const Price& reference_price) {
+    EventRecord record = blank_record(sequence, EventType::UNCROSSED);
+    record.price = reference_price.raw_value();
+    return record;
+}
+
+EventRecord make_time_record(uint64_t sequence, std::chrono::system_clock::time_point now) {
+    EventRecord record = blank_record(sequence, EventType::TIME_ADVANCED);
+    record.timestamp_ns = to_ns(now);
+    return record;
+}
+
+EventRecord make_checkpoint_record(uint64_t sequence, uint64_t book_checksum) {
+    EventRecord record = blank_record(sequence, EventType::CHECKPOINT);
+    record.payload = book_checksum;
+    return record;
+}
+
+EventRecord make_checkpoint_record(uint64_t sequence, uint64_t book_checksum, uint64_t output_hash) {
+    EventRecord record = make_checkpoint_record(sequence, book_checksum);
+    record.flags |= CHECKPOINT_HAS_OUTPUT_HASH;
+    std::memcpy(&record.price, &output_hash, sizeof(output_hash));
+    return record;
+}
+
+Order order_from_record(const EventRecord& record, const EventRecord* extension) {
+    size_t length = strnlen(record.client, sizeof(record.client));
+    std::chrono::system_clock::time_point timestamp = to_time_point(record.timestamp_ns);
+
+    Order order(
+        std::string_view(record.client, length),
+        Price::fromRaw(record.price),
+        record.order_id,
+        record.volume,
+        record.side == 0 ? Side::BUY : Side::SELL,
+        timestamp
+    );
+    order.set_time_in_force(static_cast<TimeInForce>(record.flags & PLACE_TIME_IN_FORCE_MASK));
+    order.set_order_type(static_cast<OrderType>(record.order_type));
+    order.set_protection_ticks(record.aux);
+    order.set_peak_size(static_cast<int>(record.payload));
+    if (extension) {
+        order.set_stop_price(Price::fromRaw(extension->price));
+        order.set_expire_time(to_time_point(extension->timestamp_ns));
+        order.set_participant_id(extension->aux);
+    }
+    return order;
+}
+
+MassCancelFilter mass_cancel_filter_from_record(const EventRecord& record) {
+    MassCancelFilter filter;
+    filter.include_buys = (record.flags & MASS_CANCEL_BUYS) != 0;
+    filter.include_sells = (record.flags & MASS_CANCEL_SELLS) != 0;
+    filter.min_price = Price::fromRaw(record.price);
+    filter.max_price = Price::fromRaw(static_cast<int64_t>(record.payload));
+    return filter;
+}
+
+std::vector<EventRecord> read_journal(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        throw std::system_error(errno, std::generic_category(), "read_journal: cannot open " + path);
+    }
+
+    in.seekg(0, std::ios::end);
+    std::streamoff size = in.tellg();
+    in.seekg(0, std::ios::beg);
+
+    std::vector<EventRecord> records(static_cast<size_t>(size) / sizeof(EventRecord));
+    in.read(reinterpret_cast<char*>(records.data()),
+            static_cast<std::streamsize>(records.size() * sizeof(EventRecord)));
+    return records;
+}
+
+}
+}
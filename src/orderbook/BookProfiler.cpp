@@ -0,0 +1,87 @@
+#include "../../include/orderbook/BookProfiler.h"
+#include <iomanip>
+
+namespace trading {
+
+namespace {
+
+const char* operation_name(BookOperation op) {
+    switch (op) {
+        case BookOperation::PLACE: return "place";
+        case BookOperation::CANCEL: return "cancel";
+        case BookOperation::MODIFY: return "modify";
+        case BookOperation::MATCH: return "match";
+        default: return "?";
+    }
+}
+
+}
+
+void BookProfiler::accumulate(BookOperation op) {
+    Totals& totals = totals_[static_cast<size_t>(op)];
+    totals.calls++;
+
+    uint64_t enabled = after_.time_enabled - before_.time_enabled;
+    uint64_t running = after_.time_running - before_.time_running;
+    if (running == 0) {
+        totals.unscheduled++;
+        return;
+    }
+
+    // Extrapolate when the group shared the PMU with other events
+    double scale = static_cast<double>(enabled) / static_cast<double>(running);
+    for (size_t i = 0; i < metrics::PERF_EVENT_COUNT; ++i) {
+        totals.events[i] += static_cast<double>(after_.values[i] - before_.values[i]) * scale;
+    }
+}
+
+void BookProfiler::print(std::ostream& out) const {
+    if (!available()) {
+        out << "Hardware counters unavailable (perf_event_open failed); profile skipped\n";
+        return;
+    }
+
+    const char* headers[] = {"cycles", "instr", "IPC", "L1D miss", "LLC miss", "br miss", "dTLB miss"};
+    out << std::left << std::setw(8) << "op" << std::right << std::setw(12) << "calls";
+    for (const char* header : headers) {
+        out << std::setw(11) << header;
+    }
+    out << "   (per call)\n";
+
+    using metrics::PerfEvent;
+    for (size_t op = 0; op < totals_.size(); ++op) {
+        const Totals& totals = totals_[op];
+        uint64_t measured = totals.calls - totals.unscheduled;
+        if (measured == 0) {
+            continue;
+        }
+
+        auto per_call = [&](PerfEvent event) {
+            return totals.events[static_cast<size_t>(event)] / static_cast<double>(measured);
+        };
+        double cycles = per_call(PerfEvent::CYCLES);
+        double instructions = per_call(PerfEvent::INSTRUCTIONS);
+
+        out << std::left << std::setw(8) << operation_name(static_cast<BookOperation>(op)) << std::right
+            << std::setw(12) << totals.calls << std::fixed << std::setprecision(1) << std::setw(11) << cycles;
+        if (counters_.has(PerfEvent::INSTRUCTIONS)) {
+            out << std::setw(11) << instructions << std::setprecision(2) << std::setw(11)
+                << (cycles > 0 ? instructions / cycles : 0.0);
+        } else {
+            out << std::setw(11) << "n/a" << std::setw(11) << "n/a";
+        }
+        out << std::setprecision(2);
+        for (PerfEvent event : {PerfEvent::L1D_MISSES, PerfEvent::LLC_MISSES, PerfEvent::BRANCH_MISSES,
+                                PerfEvent::DTLB_MISSES}) {
+            if (counters_.has(event)) {
+                out << std::setw(11) << per_call(event);
+            } else {
+                out << std::setw(11) << "n/a";
+            }
+        }
+        out << "\n";
+        out.unsetf(std::ios::floatfield);
+    }
+}
+
+}
@@ -7,7 +7,7 @@ int Order::next_order_id_ = 1;
 
 // Constructors
 Order::Order():
-	client_(""),
+	client_(),
 	price_(0),
 	order_id_(0),
 	volume_(0),
@@ -19,7 +19,7 @@ Order::Order():
 {}
 
 // Full control constructor
-Order::Order(std::string _client, Price _price, int _order_id, int _volume, Side _side, std::chrono::system_clock::time_point _timestamp):
+Order::Order(ClientName _client, Price _price, int _order_id, int _volume, Side _side, std::chrono::system_clock::time_point _timestamp):
 	client_{_client},
 	price_{_price},
 	order_id_{_order_id},
@@ -32,7 +32,7 @@ Order::Order(std::string _client, Price _price, int _order_id, int _volume, Side
 {}
 
 // Auto-generated order_id, manual timestamp
-Order::Order(std::string _client, Price _price, int _volume, Side _side, std::chrono::system_clock::time_point _timestamp):
+Order::Order(ClientName _client, Price _price, int _volume, Side _side, std::chrono::system_clock::time_point _timestamp):
 	client_{_client},
 	price_{_price},
 	order_id_{next_order_id_++},
@@ -45,7 +45,7 @@ Order::Order(std::string _client, Price _price, int _volume, Side _side, std::ch
 {}
 
 // Auto-generated order_id and timestamp
-Order::Order(std::string _client, Price _price, int _volume, Side _side):
+Order::Order(ClientName _client, Price _price, int _volume, Side _side):
 	client_{_client},
 	price_{_price},
 	order_id_{next_order_id_++},
@@ -58,7 +58,7 @@ Order::Order(std::string _client, Price _price, int _volume, Side _side):
 {}
 
 // Compatibility constructors with double price
-Order::Order(std::string _client, double _price, int _order_id, int _volume, Side _side, std::chrono::system_clock::time_point _timestamp):
+Order::Order(ClientName _client, double _price, int _order_id, int _volume, Side _side, std::chrono::system_clock::time_point _timestamp):
     client_(_client),
     price_(Price(_price)),
     order_id_(_order_id),
@@ -70,7 +70,7 @@ Order::Order(std::string _client, double _price, int _order_id, int _volume, Sid
     level(nullptr)
 {}
 
-Order::Order(std::string _client, double _price, int _volume, Side _side, std::chrono::system_clock::time_point _timestamp):
+Order::Order(ClientName _client, double _price, int _volume, Side _side, std::chrono::system_clock::time_point _timestamp):
     client_(_client),
     price_(Price(_price)),
     order_id_(next_order_id_++),
@@ -82,7 +82,7 @@ Order::Order(std::string _client, double _price, int _volume, Side _side, std::c
     level(nullptr)
 {}
 
-Order::Order(std::string _client, double _price, int _volume, Side _side):
+Order::Order(ClientName _client, double _price, int _volume, Side _side):
     client_(_client),
     price_(Price(_price)),
     order_id_(next_order_id_++),
@@ -95,20 +95,36 @@ Order::Order(std::string _client, double _price, int _volume, Side _side):
 {}
 
 // Getters
-std::string Order::get_client() const { return client_; }
+const ClientName& Order::get_client() const { return client_; }
 Price Order::get_price() const { return price_; }
 int Order::get_order_id() const { return order_id_; }
 int Order::get_volume() const { return volume_; }
 Side Order::get_side() const { return side_; }
 std::chrono::system_clock::time_point Order::get_timestamp() const { return timestamp_; }
+TimeInForce Order::get_time_in_force() const { return time_in_force_; }
+OrderType Order::get_order_type() const { return order_type_; }
+int Order::get_protection_ticks() const { return protection_ticks_; }
+int Order::get_peak_size() const { return peak_size_; }
+int Order::get_hidden_volume() const { return hidden_volume_; }
+Price Order::get_stop_price() const { return stop_price_; }
+std::chrono::system_clock::time_point Order::get_expire_time() const { return expire_time_; }
+int Order::get_participant_id() const { return participant_id_; }
 
 // Setters
-void Order::set_client(std::string new_client) { client_ = new_client; }
+void Order::set_client(ClientName new_client) { client_ = new_client; }
 void Order::set_price(Price new_price) { price_ = new_price; }
 void Order::set_order_id(int new_order_id) { order_id_ = new_order_id; }
 void Order::set_volume(int new_volume) { volume_ = new_volume; }
 void Order::set_side(Side new_side) { side_ = new_side; }
 void Order::set_timestamp(std::chrono::system_clock::time_point new_timestamp) { timestamp_ = new_timestamp; }
+void Order::set_time_in_force(TimeInForce new_time_in_force) { time_in_force_ = new_time_in_force; }
+void Order::set_order_type(OrderType new_order_type) { order_type_ = new_order_type; }
+void Order::set_protection_ticks(int new_protection_ticks) { protection_ticks_ = new_protection_ticks; }
+void Order::set_peak_size(int new_peak_size) { peak_size_ = new_peak_size; }
+void Order::set_hidden_volume(int new_hidden_volume) { hidden_volume_ = new_hidden_volume; }
+void Order::set_stop_price(Price new_stop_price) { stop_price_ = new_stop_price; }
+void Order::set_expire_time(std::chrono::system_clock::time_point new_expire_time) { expire_time_ = new_expire_time; }
+void Order::set_participant_id(int new_participant_id) { participant_id_ = new_participant_id; }
 
 // Static method to reset order ID counter
 void Order::reset_order_id_counter(int start_id) {
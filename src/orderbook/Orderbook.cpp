@@ -1,18 +1,44 @@
 #include "../../include/orderbook/Orderbook.h"
+#include <algorithm>
 #include <iostream>
 #include <iomanip>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <utility>
 
 namespace trading {
 
-Orderbook::Orderbook() :
+// Times the rest of the enclosing scope into the operation's histogram
+#if ORDERBOOK_LATENCY_STATS
+#define ORDERBOOK_TIME_SCOPE(op) metrics::ScopedLatency latency_scope_(latency_histogram(op))
+#else
+#define ORDERBOOK_TIME_SCOPE(op)
+#endif
+
+template <typename MatchingPolicy>
+BasicOrderbook<MatchingPolicy>::BasicOrderbook() : BasicOrderbook(Price::fromRaw(100)) {}
+
+template <typename MatchingPolicy>
+BasicOrderbook<MatchingPolicy>::BasicOrderbook(Price tick_size) : BasicOrderbook(TickTable(tick_size)) {}
+
+template <typename MatchingPolicy>
+BasicOrderbook<MatchingPolicy>::BasicOrderbook(const TickTable& tick_table) :
     order_pool_(),
     level_pool_(),
     bid_levels_(true, level_pool_),  // true for bid side (descending prices)
     ask_levels_(false, level_pool_), // false for ask side (ascending prices)
-    order_map_()
-{}
+    order_map_(),
+    tick_table_(tick_table),
+    tick_size_(tick_table.min_tick())
+{
+#if ORDERBOOK_LATENCY_STATS
+    latency_ = std::make_unique<LatencyHistograms>();
+#endif
+}
 
-Orderbook::~Orderbook() {
+template <typename MatchingPolicy>
+BasicOrderbook<MatchingPolicy>::~BasicOrderbook() {
     // Clear all orders first (to avoid dangling pointers)
     order_map_.clear();
     
@@ -20,30 +46,117 @@ Orderbook::~Orderbook() {
 }
 
 
+// Moving a book moves these members; none of them may allocate or throw
+static_assert(std::is_nothrow_move_constructible<memory::MemoryPool<Order>>::value, "");
+static_assert(std::is_nothrow_move_constructible<FlatHashMap<int, Order*>>::value, "");
+static_assert(std::is_nothrow_copy_constructible<TickTable>::value, "");
+static_assert(std::is_nothrow_move_constructible<TimerWheel>::value, "");
+static_assert(std::is_nothrow_move_constructible<ParticipantIndex>::value, "");
+static_assert(std::is_nothrow_move_constructible<std::map<int64_t, PriceLevel*>>::value, "");
+
 // Move constructor
-Orderbook::Orderbook(Orderbook&& other) noexcept :
+template <typename MatchingPolicy>
+BasicOrderbook<MatchingPolicy>::BasicOrderbook(BasicOrderbook&& other) noexcept :
     order_pool_(std::move(other.order_pool_)),
     level_pool_(std::move(other.level_pool_)),
-    bid_levels_(true, level_pool_),
-    ask_levels_(false, level_pool_),
-    order_map_(std::move(other.order_map_))
+    // Pool blocks are heap allocations, so levels keep their addresses; only
+    // the lists' pool binding changes
+    bid_levels_(std::move(other.bid_levels_), level_pool_),
+    ask_levels_(std::move(other.ask_levels_), level_pool_),
+    order_map_(std::move(other.order_map_)),
+    policy_(other.policy_),
+    tick_table_(other.tick_table_),
+    tick_size_(other.tick_size_),
+    phase_(other.phase_),
+    buy_stops_(std::move(other.buy_stops_)),
+    sell_stops_(std::move(other.sell_stops_)),
+    triggered_stops_(std::move(other.triggered_stops_)),
+    last_trade_price_(other.last_trade_price_),
+    trade_count_(other.trade_count_),
+    timer_wheel_(std::move(other.timer_wheel_)),
+    expired_orders_(std::move(other.expired_orders_)),
+    current_time_(other.current_time_),
+    session_end_(other.session_end_),
+    participants_(std::move(other.participants_)),
+    emptied_levels_(std::move(other.emptied_levels_)),
+    stp_mode_(other.stp_mode_),
+    discarded_trades_(std::move(other.discarded_trades_)),
+    output_hash_enabled_(other.output_hash_enabled_),
+    output_hash_(other.output_hash_),
+    aggregator_(std::exchange(other.aggregator_, nullptr))
+#if ORDERBOOK_LATENCY_STATS
+    , latency_(std::move(other.latency_))
+#endif
 {
-    // Note: bid_levels_ and ask_levels_ are reconstructed with new pool reference
-    // Original design with references makes true move semantics impossible
+    // Leave other empty: its pools are gone, so nothing may point into them.
+    // It no longer reports into the aggregator either.
+    other.trade_count_ = 0;
+    other.output_hash_ = 0;
 }
 
-// Move assignment
-Orderbook& Orderbook::operator=(Orderbook&& other) noexcept {
+// Move assignment; the previous contents are released here
+template <typename MatchingPolicy>
+BasicOrderbook<MatchingPolicy>& BasicOrderbook<MatchingPolicy>::operator=(BasicOrderbook&& other) noexcept {
     if (this != &other) {
-        order_pool_ = std::move(other.order_pool_);
-        level_pool_ = std::move(other.level_pool_);
-        order_map_ = std::move(other.order_map_);
-        // bid_levels_ and ask_levels_ cannot be moved due to reference members
+        BasicOrderbook moved(std::move(other));
+        swap(moved);
     }
     return *this;
 }
+
+template <typename MatchingPolicy>
+void BasicOrderbook<MatchingPolicy>::swap(BasicOrderbook& other) noexcept {
+    using std::swap;
+    // Each side list stays bound to its owner's level pool, which swaps with it
+    swap(order_pool_, other.order_pool_);
+    swap(level_pool_, other.level_pool_);
+    bid_levels_.swap(other.bid_levels_);
+    ask_levels_.swap(other.ask_levels_);
+    order_map_.swap(other.order_map_);
+    swap(policy_, other.policy_);
+    swap(tick_table_, other.tick_table_);
+    swap(tick_size_, other.tick_size_);
+    swap(phase_, other.phase_);
+    swap(buy_stops_, other.buy_stops_);
+    swap(sell_stops_, other.sell_stops_);
+    swap(triggered_stops_, other.triggered_stops_);
+    swap(last_trade_price_, other.last_trade_price_);
+    swap(trade_count_, other.trade_count_);
+    timer_wheel_.swap(other.timer_wheel_);
+    swap(expired_orders_, other.expired_orders_);
+    swap(current_time_, other.current_time_);
+    swap(session_end_, other.session_end_);
+    swap(participants_, other.participants_);
+    swap(emptied_levels_, other.emptied_levels_);
+    swap(stp_mode_, other.stp_mode_);
+    swap(discarded_trades_, other.discarded_trades_);
+    swap(output_hash_enabled_, other.output_hash_enabled_);
+    swap(output_hash_, other.output_hash_);
+    swap(aggregator_, other.aggregator_);
+#if ORDERBOOK_LATENCY_STATS
+    swap(latency_, other.latency_);
+#endif
+}
 	
-OrderResult Orderbook::place_order(const Order& order, std::vector<TradeInfo>& trades) {
+template <typename MatchingPolicy>
+OrderResult BasicOrderbook<MatchingPolicy>::place_order(const Order& order, std::vector<TradeInfo>& trades) {
+    ORDERBOOK_TIME_SCOPE(BookOperation::PLACE);
+    return execute_order(order, trades, nullptr);
+}
+
+template <typename MatchingPolicy>
+OrderResult BasicOrderbook<MatchingPolicy>::place_order(const Order& order, std::vector<TradeInfo>& trades,
+                                   std::vector<LevelFillInfo>& level_fills) {
+    ORDERBOOK_TIME_SCOPE(BookOperation::PLACE);
+    return execute_order(order, trades, &level_fills);
+}
+
+template <typename MatchingPolicy>
+OrderResult BasicOrderbook<MatchingPolicy>::execute_order(const Order& order, std::vector<TradeInfo>& trades,
+                                     std::vector<LevelFillInfo>* level_fills) {
+    ORDERBOOK_TRACE(PLACE, order.get_order_id(), order.get_price().raw_value(), order.get_volume(), 0,
+                    order.get_side() == Side::BUY ? 0 : 1);
+
     // Validate order first
     if (!is_valid_order(order)) {
         return OrderResult::INVALID_ORDER;
@@ -53,45 +166,254 @@ OrderResult Orderbook::place_order(const Order& order, std::vector<TradeInfo>& t
         return OrderResult::DUPLICATE_ORDER_ID;
     }
 
-	// Allocate order
-	Order* new_order = order_pool_.allocate();
+    // Stops wait outside the visible book until the last trade crosses them
+    if (is_stop_order(order)) {
+        return place_stop(order, trades, level_fills);
+    }
 
-	// Move order data
-	new (new_order) Order(order);
-	new_order->next = nullptr;
-	new_order->prev = nullptr;
-	new_order->level = nullptr;
+    // Auctions only collect resting interest
+    if (phase_ == TradingPhase::AUCTION) {
+        bool immediate = order.get_order_type() == OrderType::MARKET ||
+                         order.get_time_in_force() == TimeInForce::IOC ||
+                         order.get_time_in_force() == TimeInForce::FOK;
+        if (immediate) {
+            return OrderResult::REJECTED;
+        }
+        Price limit;
+        if (!admit_order(order, limit)) {
+            return OrderResult::CANCELLED;
+        }
+        Order* new_order = allocate_order(order);
+        set_limit(new_order, limit);
+        rest_order(new_order);
+        return OrderResult::SUCCESS;
+    }
 
-	int initial_volume = new_order->get_volume();
+    Price limit;
+    if (!admit_order(order, limit)) {
+        return OrderResult::CANCELLED;
+    }
+
+	Order* new_order = allocate_order(order);
+	set_limit(new_order, limit);
+
+	uint64_t trades_before = trade_count_;
+	OrderResult result = match_and_rest(new_order, trades, level_fills);
+
+	// Trades may have released stops
+	if (trade_count_ != trades_before && has_pending_stops()) {
+		run_stop_cascade(trades, level_fills);
+	}
+
+	return result;
+}
+
+template <typename MatchingPolicy>
+bool BasicOrderbook<MatchingPolicy>::admit_order(const Order& order, Price& limit) const {
+    limit = order.get_price();
+
+    // Market orders trade down to their protection band, or the whole side without one
+    if (order.get_order_type() == OrderType::MARKET) {
+        bool no_liquidity = (order.get_side() == Side::BUY) ? ask_levels_.empty() : bid_levels_.empty();
+        if (no_liquidity) {
+            return false;
+        }
+        limit = market_limit_price(order);
+    }
+
+    // Already past its expiry on arrival
+    if (has_expiry(order) && expire_time_of(order) <= current_time_) {
+        return false;
+    }
 
+    // Fill-or-kill is decided from level totals before anything is mutated
+    if (order.get_time_in_force() == TimeInForce::FOK && !can_fill_completely(order, limit)) {
+        return false;
+    }
+
+    return true;
+}
+
+template <typename MatchingPolicy>
+OrderResult BasicOrderbook<MatchingPolicy>::match_and_rest(Order* new_order, std::vector<TradeInfo>& trades,
+                                      std::vector<LevelFillInfo>* level_fills) {
+	int initial_volume = new_order->get_volume();
+	bool is_market = new_order->get_order_type() == OrderType::MARKET;
+	uint64_t trade_count_before = trade_count_;
+	stp_cancelled_ = false;
+	stp_decremented_ = false;
 
 	// Match order
 	if (new_order->get_side() == Side::BUY) {
-		match_against_asks(new_order, trades);
+		match_against_asks(new_order, trades, level_fills);
 	} else {
-		match_against_bids(new_order, trades);
+		match_against_bids(new_order, trades, level_fills);
+	}
+
+	// Cancelled by self-trade prevention - counts as cancelled, not filled
+	if (stp_cancelled_) {
+		bool any_fill = trade_count_before != trade_count_;
+		order_pool_.deallocate(new_order);
+		return any_fill ? OrderResult::PARTIAL_FILL : OrderResult::CANCELLED;
+	}
+
+	// Market, IOC and FOK orders never rest - drop whatever is left
+	bool immediate = new_order->get_time_in_force() == TimeInForce::IOC ||
+	                 new_order->get_time_in_force() == TimeInForce::FOK;
+	if (new_order->get_volume() > 0 && (is_market || immediate)) {
+		bool any_fill = new_order->get_volume() < initial_volume;
+		order_pool_.deallocate(new_order);
+		return any_fill ? OrderResult::PARTIAL_FILL : OrderResult::CANCELLED;
 	}
 
 	// If any volume remains, add to book
 	if (new_order->get_volume() > 0) {
-		add_order_to_book(new_order);
+		bool any_fill = new_order->get_volume() < initial_volume;
 
-		order_map_[new_order->get_order_id()] = new_order;
+		rest_order(new_order);
 
-		if (new_order->get_volume() < initial_volume) {
+		if (any_fill) {
 			return OrderResult::PARTIAL_FILL;
 		} else {
 			return OrderResult::SUCCESS;
 		}
 	} else {
-		// Fully filled so deallocate
+		// Fully filled so deallocate - unless STP shrank it on the way, in which
+		// case less traded than was asked for
 		order_pool_.deallocate(new_order);
-		return OrderResult::COMPLETE_FILL;
+		return stp_decremented_ ? OrderResult::PARTIAL_FILL : OrderResult::COMPLETE_FILL;
+	}
+
+}
+
+template <typename MatchingPolicy>
+void BasicOrderbook<MatchingPolicy>::rest_order(Order* order) {
+	queue_order(order);
+	schedule_expiry(order);
+	participants_.link(order);
+
+	order_map_[order->get_order_id()] = order;
+}
+
+template <typename MatchingPolicy>
+void BasicOrderbook<MatchingPolicy>::queue_order(Order* order) {
+	// Icebergs rest with one peak displayed and the rest held in reserve
+	if (order->is_iceberg() && order->get_volume() > order->get_peak_size()) {
+		order->set_hidden_volume(order->get_volume() - order->get_peak_size());
+		order->set_volume(order->get_peak_size());
 	}
 
+	add_order_to_book(order);
+}
+
+template <typename MatchingPolicy>
+OrderResult BasicOrderbook<MatchingPolicy>::place_stop(const Order& order, std::vector<TradeInfo>& trades,
+                                  std::vector<LevelFillInfo>* level_fills) {
+    Order* stop = allocate_order(order);
+
+    auto& index = (stop->get_side() == Side::BUY) ? buy_stops_ : sell_stops_;
+    int64_t trigger = tick_table_.to_index(stop->get_stop_price());
+    PriceLevel*& bucket = index[trigger];
+    if (!bucket) {
+        bucket = level_pool_.allocate();
+        new (bucket) PriceLevel(stop->get_stop_price(), trigger);
+    }
+    bucket->add_order(stop);
+    schedule_expiry(stop);
+    participants_.link(stop);
+    order_map_[stop->get_order_id()] = stop;
+
+    // Already through the trigger - fire straight away
+    if (last_trade_price_.raw_value() > 0 && phase_ == TradingPhase::CONTINUOUS) {
+        run_stop_cascade(trades, level_fills);
+    }
+
+    return OrderResult::SUCCESS;
+}
+
+template <typename MatchingPolicy>
+void BasicOrderbook<MatchingPolicy>::remove_stop(Order* stop) {
+    auto& index = (stop->get_side() == Side::BUY) ? buy_stops_ : sell_stops_;
+    PriceLevel* bucket = stop->level;
+
+    bucket->remove_order(stop);
+    if (bucket->get_order_count() == 0) {
+        index.erase(bucket->get_tick());
+        level_pool_.deallocate(bucket);
+    }
 }
 
-OrderResult Orderbook::cancel_order(int order_id) {
+template <typename MatchingPolicy>
+void BasicOrderbook<MatchingPolicy>::collect_triggered_stops() {
+    int64_t last_trade = tick_table_.to_index(last_trade_price_);
+
+    // Buy stops fire once the market trades at or above them, lowest trigger first
+    while (!buy_stops_.empty()) {
+        auto it = buy_stops_.begin();
+        if (it->first > last_trade) break;
+        release_stop_bucket(it->second);
+        buy_stops_.erase(it);
+    }
+
+    // Sell stops fire once the market trades at or below them, highest trigger first
+    while (!sell_stops_.empty()) {
+        auto it = std::prev(sell_stops_.end());
+        if (it->first < last_trade) break;
+        release_stop_bucket(it->second);
+        sell_stops_.erase(it);
+    }
+}
+
+template <typename MatchingPolicy>
+void BasicOrderbook<MatchingPolicy>::release_stop_bucket(PriceLevel* bucket) {
+    Order* stop = bucket->head;
+    while (stop) {
+        Order* next = stop->next;
+        stop->next = nullptr;
+        stop->prev = nullptr;
+        stop->level = nullptr;
+        timer_wheel_.cancel(stop);
+        participants_.unlink(stop);
+        order_map_.erase(stop->get_order_id());
+        triggered_stops_.push_back(stop);
+        stop = next;
+    }
+
+    bucket->clear();
+    level_pool_.deallocate(bucket);
+}
+
+template <typename MatchingPolicy>
+void BasicOrderbook<MatchingPolicy>::run_stop_cascade(std::vector<TradeInfo>& trades, std::vector<LevelFillInfo>* level_fills) {
+    collect_triggered_stops();
+
+    // Activations can trade and release further stops; they join the back of the
+    // queue so the whole cascade runs here without recursion
+    for (size_t i = 0; i < triggered_stops_.size(); ++i) {
+        Order* stop = triggered_stops_[i];
+        stop->set_order_type(stop->get_order_type() == OrderType::STOP ? OrderType::MARKET : OrderType::LIMIT);
+
+        Price limit;
+        if (!admit_order(*stop, limit)) {
+            order_pool_.deallocate(stop);
+            continue;
+        }
+        set_limit(stop, limit);
+
+        uint64_t trades_before = trade_count_;
+        match_and_rest(stop, trades, level_fills);
+        if (trade_count_ != trades_before) {
+            collect_triggered_stops();
+        }
+    }
+
+    triggered_stops_.clear();
+}
+
+template <typename MatchingPolicy>
+OrderResult BasicOrderbook<MatchingPolicy>::cancel_order(int order_id) {
+    ORDERBOOK_TIME_SCOPE(BookOperation::CANCEL);
+    ORDERBOOK_TRACE(CANCEL, order_id, 0, 0, 0, 0);
   	auto it = order_map_.find(order_id);
   	if (it == order_map_.end()) {
 	  	return OrderResult::ORDER_NOT_FOUND;
@@ -100,18 +422,25 @@ OrderResult Orderbook::cancel_order(int order_id) {
 	Order* order = it->second;
 	PriceLevel* level = order->level;
 
+	timer_wheel_.cancel(order);
+	participants_.unlink(order);
+
+	// Pending stops live in the trigger index, not the book
+	if (is_stop_order(*order)) {
+		remove_stop(order);
+		order_map_.erase(order_id);
+		order_pool_.deallocate(order);
+		return OrderResult::SUCCESS;
+	}
+
 	// Remove from price level
 	if (level) {
-		level->remove_order(order);
+		PriceLevelList& levels = (order->get_side() == Side::BUY) ? bid_levels_ : ask_levels_;
+		levels.remove_order(level, order);
 
 		// If price level is empty remove the level
 		if (level->get_order_count() == 0) {
-			if (order->get_side() == Side::BUY) {
-				bid_levels_.remove_level(level);
-			} else {
-				ask_levels_.remove_level(level);
-			}
-
+			levels.remove_level(level);
 			level_pool_.deallocate(level);
 		}
 	}
@@ -125,7 +454,119 @@ OrderResult Orderbook::cancel_order(int order_id) {
 	return OrderResult::SUCCESS;
 }
 
-OrderResult Orderbook::modify_order(int order_id, const Price& new_price, int new_volume) {
+template <typename MatchingPolicy>
+size_t BasicOrderbook<MatchingPolicy>::mass_cancel(int participant_id, const MassCancelFilter& filter) {
+    if (participant_id == 0) {
+        return 0;
+    }
+
+    size_t cancelled = 0;
+    Order* order = participants_.head(participant_id);
+    while (order) {
+        Order* next = order->participant_next;
+
+        bool side_ok = order->get_side() == Side::BUY ? filter.include_buys : filter.include_sells;
+        bool above_min = filter.min_price.raw_value() == 0 || order->get_price() >= filter.min_price;
+        bool below_max = filter.max_price.raw_value() == 0 || order->get_price() <= filter.max_price;
+        if (!side_ok || !above_min || !below_max) {
+            order = next;
+            continue;
+        }
+
+        timer_wheel_.cancel(order);
+        participants_.unlink(order);
+        order_map_.erase(order->get_order_id());
+
+        if (is_stop_order(*order)) {
+            remove_stop(order);
+        } else {
+            // Emptied levels are released together once every order is out
+            PriceLevel* level = order->level;
+            PriceLevelList& levels = (order->get_side() == Side::BUY) ? bid_levels_ : ask_levels_;
+            levels.remove_order(level, order);
+            if (level->get_order_count() == 0) {
+                emptied_levels_.emplace_back(order->get_side(), level);
+            }
+        }
+
+        order_pool_.deallocate(order);
+        cancelled++;
+        order = next;
+    }
+
+    for (auto& [side, level] : emptied_levels_) {
+        (side == Side::BUY ? bid_levels_ : ask_levels_).remove_level(level);
+        level_pool_.deallocate(level);
+    }
+    emptied_levels_.clear();
+
+    return cancelled;
+}
+
+template <typename MatchingPolicy>
+size_t BasicOrderbook<MatchingPolicy>::advance_time(std::chrono::system_clock::time_point now) {
+    if (now <= current_time_) {
+        return 0;
+    }
+    current_time_ = now;
+
+    auto since_epoch = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch());
+    uint64_t tick = static_cast<uint64_t>(since_epoch.count());
+    timer_wheel_.advance(tick, expired_orders_);
+
+    // Expired orders leave through the normal cancel path. Ticks round down, so
+    // an order due later within the current millisecond waits for the next tick.
+    size_t expired = 0;
+    for (Order* order : expired_orders_) {
+        if (order->get_expire_time() > now) {
+            timer_wheel_.schedule(order, tick + 1);
+            continue;
+        }
+        cancel_order(order->get_order_id());
+        expired++;
+    }
+    expired_orders_.clear();
+
+    return expired;
+}
+
+template <typename MatchingPolicy>
+std::chrono::system_clock::time_point BasicOrderbook<MatchingPolicy>::expire_time_of(const Order& order) const {
+    return order.get_time_in_force() == TimeInForce::DAY ? session_end_ : order.get_expire_time();
+}
+
+template <typename MatchingPolicy>
+void BasicOrderbook<MatchingPolicy>::schedule_expiry(Order* order) {
+    if (!has_expiry(*order)) {
+        return;
+    }
+
+    auto to_tick = [](std::chrono::system_clock::time_point time) {
+        return static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::milliseconds>(time.time_since_epoch()).count());
+    };
+    uint64_t expiry = to_tick(order->get_expire_time());
+
+    // An idle wheel starts at the book clock, or at the order's arrival while
+    // the clock is unset, instead of walking up from tick 0
+    if (timer_wheel_.size() == 0) {
+        auto now = current_time_ != std::chrono::system_clock::time_point{} ? current_time_ : order->get_timestamp();
+        timer_wheel_.start(std::min(to_tick(now), expiry - 1));
+    }
+    timer_wheel_.schedule(order, expiry);
+}
+
+template <typename MatchingPolicy>
+OrderResult BasicOrderbook<MatchingPolicy>::modify_order(int order_id, const Price& new_price, int new_volume) {
+    discarded_trades_.clear();
+    return modify_order(order_id, new_price, new_volume, discarded_trades_);
+}
+
+template <typename MatchingPolicy>
+OrderResult BasicOrderbook<MatchingPolicy>::modify_order(int order_id, const Price& new_price, int new_volume,
+                                                         std::vector<TradeInfo>& trades) {
+    ORDERBOOK_TIME_SCOPE(BookOperation::MODIFY);
+    ORDERBOOK_TRACE(MODIFY, order_id, new_price.raw_value(), new_volume, 0, 0);
     // Find the order
     auto it = order_map_.find(order_id);
     if (it == order_map_.end()) {
@@ -134,99 +575,111 @@ OrderResult Orderbook::modify_order(int order_id, const Price& new_price, int ne
 
 	Order* order = it->second;
 
-	// Handle volume reduction and no price change
-	if (new_price == order->get_price() && new_volume < order->get_volume()) {
-        int old_volume = order->get_volume();
-        order->set_volume(new_volume);
-        
-        // Update volume at price level
-        if (order->level) {
-            order->level->update_volume(order, old_volume);
-        }
-        
+	// Pending stops only support shrinking in place
+	if (is_stop_order(*order)) {
+		if (new_price != order->get_price() || new_volume >= order->get_volume() || new_volume <= 0) {
+			return OrderResult::REJECTED;
+		}
+		int old_volume = order->get_volume();
+		order->set_volume(new_volume);
+		order->level->update_volume(order, old_volume);
+		return OrderResult::SUCCESS;
+	}
+
+	if (new_volume <= 0 || !tick_table_.is_valid(new_price)) {
+		return OrderResult::INVALID_ORDER;
+	}
+
+	PriceLevelList& levels = (order->get_side() == Side::BUY) ? bid_levels_ : ask_levels_;
+
+	// Handle volume reduction and no price change - keeps queue position. An
+	// iceberg gives up reserve before any of its displayed peak.
+	if (new_price == order->get_price() &&
+	    new_volume < order->get_volume() + order->get_hidden_volume()) {
+        int displayed = std::min(order->get_volume(), new_volume);
+        levels.resize(order->level, order, displayed, new_volume - displayed);
         return OrderResult::SUCCESS;
     }
 
-	// For all other cases, treat as cancel + new order
-	Side side = order->get_side();
-	std::string client = order->get_client();
-	std::chrono::system_clock::time_point timestamp = std::chrono::system_clock::now();
+	// Anything else loses priority: unlink the same pooled order, update it, match
+	// it if it now crosses and queue it at the new level's tail. The order_map_
+	// entry, expiry timer and participant link all stay in place.
+	PriceLevel* level = order->level;
+	levels.remove_order(level, order);
+	if (level->get_order_count() == 0) {
+		levels.remove_level(level);
+		level_pool_.deallocate(level);
+	}
 
-	// Cancel existing order
-    auto result = cancel_order(order_id);
-    if (result != OrderResult::SUCCESS) {
-        return result;
-    }
-    
-    // Create a new order with same ID
-    Order new_order(
-        client,
-        new_price,
-        order_id,
-        new_volume,
-        side,
-		timestamp
-    );
-    
-    // Place the new order
-    std::vector<TradeInfo> trades;
-    return place_order(new_order, trades);
+	// new_volume is the whole remaining quantity; queue_order splits an
+	// iceberg's peak back out when it rests
+	set_limit(order, new_price);
+	order->set_volume(new_volume);
+	order->set_hidden_volume(0);
+	order->set_timestamp(std::chrono::system_clock::now());
+
+	if (phase_ == TradingPhase::AUCTION) {
+		queue_order(order);
+		return OrderResult::SUCCESS;
+	}
+
+	uint64_t trades_before = trade_count_;
+	stp_cancelled_ = false;
+	stp_decremented_ = false;
+	if (order->get_side() == Side::BUY) {
+		match_against_asks(order, trades, nullptr);
+	} else {
+		match_against_bids(order, trades, nullptr);
+	}
+	bool any_fill = trade_count_ != trades_before;
+
+	OrderResult result;
+	if (order->get_volume() > 0 && !stp_cancelled_) {
+		queue_order(order);
+		result = any_fill ? OrderResult::PARTIAL_FILL : OrderResult::SUCCESS;
+	} else {
+		timer_wheel_.cancel(order);
+		participants_.unlink(order);
+		order_map_.erase(order_id);
+		order_pool_.deallocate(order);
+		result = stp_cancelled_ ? (any_fill ? OrderResult::PARTIAL_FILL : OrderResult::CANCELLED)
+		       : stp_decremented_ ? OrderResult::PARTIAL_FILL
+		                          : OrderResult::COMPLETE_FILL;
+	}
+
+	// Trades may have released stops
+	if (any_fill && has_pending_stops()) {
+		run_stop_cascade(trades, nullptr);
+	}
+
+	return result;
 }
 
-OrderResult Orderbook::match_against_asks(Order* order, std::vector<TradeInfo>& trades) {
+template <typename MatchingPolicy>
+OrderResult BasicOrderbook<MatchingPolicy>::match_against_asks(Order* order, std::vector<TradeInfo>& trades,
+                                          std::vector<LevelFillInfo>* level_fills) {
+    ORDERBOOK_TIME_SCOPE(BookOperation::MATCH);
     bool any_match = false;
 
     while (order->get_volume() > 0 && !ask_levels_.empty()) {
         PriceLevel* best_ask = ask_levels_.get_best_level();
         
         // Check if price matches
-        if (best_ask->get_price() > order->get_price()) {
+        if (best_ask->get_tick() > order->tick) {
             break; // No more matching
         }
-        
-        // Match against orders at this level
-        Order* matching_order = best_ask->head;
-        
-        while (matching_order && order->get_volume() > 0) {
-            int trade_volume = std::min(order->get_volume(), matching_order->get_volume());
-            any_match = true;
-
-            // Execute trade
-            int old_matching_volume = matching_order->get_volume();
-            int new_matching_volume = old_matching_volume - trade_volume;
-            int new_order_volume = order->get_volume() - trade_volume;
-
-            // Create trade info (before modifying volumes)
-            TradeInfo trade;
-            trade.order_id = order->get_order_id();
-            trade.client_name = order->get_client();
-            trade.price = matching_order->get_price();
-            trade.volume = trade_volume;
-            trade.is_buy = (order->get_side() == Side::BUY);
-            trade.counterparty = matching_order->get_client();
-            trades.push_back(trade);
-
-            // Get next order before potentially removing current one
-            Order* next_matching = matching_order->next;
-
-            // Update volumes and handle order lifecycle
-            if (new_matching_volume > 0) {
-                // Partially filled - update volume
-                matching_order->set_volume(new_matching_volume);
-                best_ask->update_volume(matching_order, old_matching_volume);
-            } else {
-                // Fully filled - remove before modifying volume
-                int matching_id = matching_order->get_order_id();
-                best_ask->remove_order(matching_order);
-                order_map_.erase(matching_id);
-                order_pool_.deallocate(matching_order);
-            }
+        any_match = true;
 
-            order->set_volume(new_order_volume);
-            
-            matching_order = next_matching;
+        // Whole level is consumed - release it in bulk
+        if (level_fills && !stp_applies(order) &&
+            order->get_volume() >= best_ask->get_executable_volume()) {
+            sweep_level(ask_levels_, best_ask, order, *level_fills);
+            continue;
         }
         
+        // Match against orders at this level
+        match_level(ask_levels_, best_ask, order, trades);
+        
         // If price level is empty, remove it
         if (best_ask->get_order_count() == 0) {
             PriceLevel* level_to_remove = best_ask;
@@ -244,59 +697,31 @@ OrderResult Orderbook::match_against_asks(Order* order, std::vector<TradeInfo>&
     }
 }
 
-OrderResult Orderbook::match_against_bids(Order* order, std::vector<TradeInfo>& trades) {
+template <typename MatchingPolicy>
+OrderResult BasicOrderbook<MatchingPolicy>::match_against_bids(Order* order, std::vector<TradeInfo>& trades,
+                                          std::vector<LevelFillInfo>* level_fills) {
+    ORDERBOOK_TIME_SCOPE(BookOperation::MATCH);
     bool any_match = false;
 
     while (order->get_volume() > 0 && !bid_levels_.empty()) {
         PriceLevel* best_bid = bid_levels_.get_best_level();
         
         // Check if price matches
-        if (best_bid->get_price() < order->get_price()) {
+        if (best_bid->get_tick() < order->tick) {
             break; // No more matching
         }
-        
-        // Match against orders at this level
-        Order* matching_order = best_bid->head;
-        
-        while (matching_order && order->get_volume() > 0) {
-            int trade_volume = std::min(order->get_volume(), matching_order->get_volume());
-
-            // Execute trade
-            int old_matching_volume = matching_order->get_volume();
-            int new_matching_volume = old_matching_volume - trade_volume;
-            int new_order_volume = order->get_volume() - trade_volume;
-
-            // Create trade info (before modifying volumes)
-            TradeInfo trade;
-            trade.order_id = order->get_order_id();
-            trade.client_name = order->get_client();
-            trade.price = matching_order->get_price();
-            trade.volume = trade_volume;
-            trade.is_buy = (order->get_side() == Side::BUY);
-            trade.counterparty = matching_order->get_client();
-            trades.push_back(trade);
-
-            // Get next order before potentially removing current one
-            Order* next_matching = matching_order->next;
-
-            // Update volumes and handle order lifecycle
-            if (new_matching_volume > 0) {
-                // Partially filled - update volume
-                matching_order->set_volume(new_matching_volume);
-                best_bid->update_volume(matching_order, old_matching_volume);
-            } else {
-                // Fully filled - remove before modifying volume
-                int matching_id = matching_order->get_order_id();
-                best_bid->remove_order(matching_order);
-                order_map_.erase(matching_id);
-                order_pool_.deallocate(matching_order);
-            }
+        any_match = true;
 
-            order->set_volume(new_order_volume);
-
-            matching_order = next_matching;
+        // Whole level is consumed - release it in bulk
+        if (level_fills && !stp_applies(order) &&
+            order->get_volume() >= best_bid->get_executable_volume()) {
+            sweep_level(bid_levels_, best_bid, order, *level_fills);
+            continue;
         }
         
+        // Match against orders at this level
+        match_level(bid_levels_, best_bid, order, trades);
+        
         // If price level is empty, remove it
         if (best_bid->get_order_count() == 0) {
             PriceLevel* level_to_remove = best_bid;
@@ -314,26 +739,358 @@ OrderResult Orderbook::match_against_bids(Order* order, std::vector<TradeInfo>&
     }
 }
 
-void Orderbook::add_order_to_book(Order* order) {
-    Price price = order->get_price();
+template <typename MatchingPolicy>
+void BasicOrderbook<MatchingPolicy>::match_level(PriceLevelList& levels, PriceLevel* level, Order* order,
+                            std::vector<TradeInfo>& trades) {
+    // The policy decides how much each resting order gets; every fill goes through
+    // fill_resting so trade reporting and order lifecycle stay in one place
+    policy_.match(level, order, [&](Order* resting, int volume) {
+        return fill_resting(levels, level, order, resting, volume, trades);
+    });
+}
+
+template <typename MatchingPolicy>
+bool BasicOrderbook<MatchingPolicy>::fill_resting(PriceLevelList& levels, PriceLevel* level, Order* order, Order* resting,
+                             int volume, std::vector<TradeInfo>& trades) {
+    // Self-trade prevention - a single integer compare per fill
+    if (stp_applies(order) && resting->get_participant_id() == order->get_participant_id()) {
+        return prevent_self_trade(levels, level, order, resting);
+    }
+
+    record_trade(order, resting, resting->get_price(), volume, trades);
+    order->set_volume(order->get_volume() - volume);
+
+    return reduce_resting(levels, level, resting, volume);
+}
+
+template <typename MatchingPolicy>
+void BasicOrderbook<MatchingPolicy>::record_trade(const Order* order, const Order* counterparty, const Price& price,
+                                                  int volume, std::vector<TradeInfo>& trades) {
+    TradeInfo trade;
+    trade.order_id = order->get_order_id();
+    trade.client_name = order->get_client();
+    trade.price = price;
+    trade.volume = volume;
+    trade.is_buy = (order->get_side() == Side::BUY);
+    trade.counterparty = counterparty->get_client();
+    trades.push_back(trade);
+    ORDERBOOK_TRACE(TRADE, trade.order_id, price.raw_value(), volume, counterparty->get_order_id(),
+                    trade.is_buy ? 0 : 1);
+
+    last_trade_price_ = trade.price;
+    trade_count_++;
+
+    if (output_hash_enabled_) {
+        chain_output(trade.order_id, trade.price, trade.volume, trade.is_buy);
+    }
+    if (aggregator_) {
+        aggregate_fill(order, price, volume);
+    }
+}
+
+template <typename MatchingPolicy>
+bool BasicOrderbook<MatchingPolicy>::reduce_resting(PriceLevelList& levels, PriceLevel* level, Order* resting,
+                                                    int volume) {
+    // Update volumes and handle order lifecycle
+    int old_volume = resting->get_volume();
+    if (old_volume > volume) {
+        // Partially filled - update volume
+        resting->set_volume(old_volume - volume);
+        levels.update_volume(level, resting, old_volume);
+        return true;
+    }
+    if (resting->get_hidden_volume() > 0) {
+        // Iceberg peak exhausted - refill the same slot and requeue it at the tail
+        levels.replenish(level, resting);
+        return true;
+    }
+
+    // Fully filled
+    remove_resting(levels, level, resting);
+    return false;
+}
+
+template <typename MatchingPolicy>
+void BasicOrderbook<MatchingPolicy>::sweep_level(PriceLevelList& levels, PriceLevel* level, Order* order,
+                            std::vector<LevelFillInfo>& level_fills) {
+    LevelFillInfo fill;
+    fill.order_id = order->get_order_id();
+    fill.price = level->get_price();
+    fill.volume = static_cast<int>(level->get_executable_volume());    // at most the aggressor's volume
+    fill.order_count = level->get_order_count();
+    fill.is_buy = (order->get_side() == Side::BUY);
+    level_fills.push_back(fill);
+    ORDERBOOK_TRACE(TRADE, fill.order_id, fill.price.raw_value(), fill.volume, 0, fill.is_buy ? 0 : 1);
+
+    last_trade_price_ = fill.price;
+    trade_count_++;
+
+    if (output_hash_enabled_) {
+        chain_output(fill.order_id, fill.price, fill.volume, fill.is_buy);
+    }
+    if (aggregator_) {
+        aggregate_fill(order, fill.price, fill.volume);
+    }
+
+    // Detach the whole queue, then hand every order back to the pool in one walk
+    Order* resting = level->head;
+    levels.clear_level(level);
+    while (resting) {
+        Order* next = resting->next;
+        timer_wheel_.cancel(resting);
+        participants_.unlink(resting);
+        order_map_.erase(resting->get_order_id());
+        order_pool_.deallocate(resting);
+        resting = next;
+    }
+
+    levels.remove_level(level);
+    level_pool_.deallocate(level);
+
+    order->set_volume(order->get_volume() - fill.volume);
+}
+
+template <typename MatchingPolicy>
+void BasicOrderbook<MatchingPolicy>::remove_resting(PriceLevelList& levels, PriceLevel* level, Order* resting) {
+    levels.remove_order(level, resting);
+    timer_wheel_.cancel(resting);
+    participants_.unlink(resting);
+    order_map_.erase(resting->get_order_id());
+    order_pool_.deallocate(resting);
+}
+
+template <typename MatchingPolicy>
+bool BasicOrderbook<MatchingPolicy>::prevent_self_trade(PriceLevelList& levels, PriceLevel* level, Order* order, Order* resting) {
+    switch (stp_mode_) {
+        case SelfTradePrevention::CANCEL_NEWEST:
+            order->set_volume(0);
+            stp_cancelled_ = true;
+            return true;
+        case SelfTradePrevention::CANCEL_OLDEST:
+            remove_resting(levels, level, resting);
+            return false;
+        case SelfTradePrevention::CANCEL_BOTH:
+            remove_resting(levels, level, resting);
+            order->set_volume(0);
+            stp_cancelled_ = true;
+            return false;
+        case SelfTradePrevention::DECREMENT_AND_CANCEL: {
+            // Applies to the resting order's displayed quantity; its reserve goes with it
+            int overlap = std::min(order->get_volume(), resting->get_volume());
+            order->set_volume(order->get_volume() - overlap);
+            stp_decremented_ = true;
+            stp_cancelled_ = order->get_volume() == 0;
+            if (overlap == resting->get_volume()) {
+                remove_resting(levels, level, resting);
+                return false;
+            }
+            int old_volume = resting->get_volume();
+            resting->set_volume(old_volume - overlap);
+            levels.update_volume(level, resting, old_volume);
+            return true;
+        }
+        case SelfTradePrevention::NONE:
+            break;
+    }
+    return true;
+}
+
+template <typename MatchingPolicy>
+AuctionResult BasicOrderbook<MatchingPolicy>::indicative_uncross(Price reference_price) const {
+    AuctionResult result;
+    if (bid_levels_.empty() || ask_levels_.empty() || get_best_bid() < get_best_ask()) {
+        return result;
+    }
+
+    if (reference_price.raw_value() == 0) {
+        reference_price = last_trade_price_;
+    }
+
+    int64_t best_bid = bid_levels_.get_best_level()->get_tick();
+    int64_t best_ask = ask_levels_.get_best_level()->get_tick();
+
+    // Demand at the lowest candidate price: every bid at or above the best ask
+    int64_t demand = 0;
+    PriceLevel* bid = nullptr;
+    for (PriceLevel* level = bid_levels_.begin(); level && level->get_tick() >= best_ask; level = bid_levels_.next(level)) {
+        demand += level->get_executable_volume();
+        bid = level;
+    }
+
+    // Walk candidate prices upwards, merging both sides: supply is a prefix sum
+    // of asks at or below the price, demand a suffix sum of bids at or above it
+    PriceLevel* ask = ask_levels_.begin();
+    int64_t supply = 0;
+
+    // Current tie set of maximum-volume, minimum-surplus candidates
+    int64_t best_volume = 0;
+    int64_t best_surplus = 0;
+    Price lowest, highest, nearest;
+    bool all_buy_pressure = true;
+    bool all_sell_pressure = true;
+
+    while (ask || bid) {
+        PriceLevel* candidate = (ask && (!bid || ask->get_tick() <= bid->get_tick())) ? ask : bid;
+        int64_t tick = candidate->get_tick();
+        Price price = candidate->get_price();
+        if (tick > best_bid) {
+            break;
+        }
+
+        if (ask && ask->get_tick() == tick) {
+            supply += ask->get_executable_volume();
+            ask = ask_levels_.next(ask);
+        }
+
+        int64_t volume = std::min(demand, supply);
+        int64_t surplus = demand - supply;
+        int64_t abs_surplus = surplus < 0 ? -surplus : surplus;
+        int64_t best_abs = best_surplus < 0 ? -best_surplus : best_surplus;
+
+        if (volume > best_volume || (volume == best_volume && volume > 0 && abs_surplus < best_abs)) {
+            best_volume = volume;
+            best_surplus = surplus;
+            lowest = highest = nearest = price;
+            all_buy_pressure = surplus > 0;
+            all_sell_pressure = surplus < 0;
+        } else if (volume == best_volume && volume > 0 && abs_surplus == best_abs) {
+            highest = price;
+            all_buy_pressure = all_buy_pressure && surplus > 0;
+            all_sell_pressure = all_sell_pressure && surplus < 0;
+
+            // Ties on distance keep the lower price
+            int64_t distance = price.raw_value() - reference_price.raw_value();
+            int64_t nearest_distance = nearest.raw_value() - reference_price.raw_value();
+            if ((distance < 0 ? -distance : distance) < (nearest_distance < 0 ? -nearest_distance : nearest_distance)) {
+                nearest = price;
+            }
+        }
+
+        // Bids at this price no longer count towards higher prices
+        if (bid && bid->get_tick() == tick) {
+            demand -= bid->get_executable_volume();
+            bid = bid->prev_price;
+        }
+    }
+
+    if (best_volume == 0) {
+        return result;
+    }
+
+    // Market pressure decides a one-sided tie, the reference price a mixed one
+    if (all_buy_pressure) {
+        result.price = highest;
+    } else if (all_sell_pressure) {
+        result.price = lowest;
+    } else {
+        result.price = nearest;
+    }
+    result.volume = best_volume;
+    result.imbalance = best_surplus;
+    return result;
+}
+
+template <typename MatchingPolicy>
+AuctionResult BasicOrderbook<MatchingPolicy>::uncross(std::vector<TradeInfo>& trades, Price reference_price) {
+    AuctionResult result = indicative_uncross(reference_price);
+    phase_ = TradingPhase::CONTINUOUS;
+
+    // Pair the best bid and best ask queues head to head, so both sides fill in
+    // price-time priority, all at the uncross price
+    int64_t remaining = result.volume;
+    while (remaining > 0) {
+        PriceLevel* bid = bid_levels_.get_best_level();
+        PriceLevel* ask = ask_levels_.get_best_level();
+        Order* buyer = bid->head;
+        Order* seller = ask->head;
+
+        int volume = static_cast<int>(std::min<int64_t>(remaining, std::min(buyer->get_volume(), seller->get_volume())));
+        record_trade(buyer, seller, result.price, volume, trades);
+        remaining -= volume;
+
+        reduce_resting(bid_levels_, bid, buyer, volume);
+        reduce_resting(ask_levels_, ask, seller, volume);
+
+        if (bid->get_order_count() == 0) {
+            bid_levels_.remove_level(bid);
+            level_pool_.deallocate(bid);
+        }
+        if (ask->get_order_count() == 0) {
+            ask_levels_.remove_level(ask);
+            level_pool_.deallocate(ask);
+        }
+    }
+
+    // The uncross price may have crossed pending stops
+    if (result.volume > 0 && has_pending_stops()) {
+        run_stop_cascade(trades, nullptr);
+    }
+
+    return result;
+}
+
+template <typename MatchingPolicy>
+Price BasicOrderbook<MatchingPolicy>::market_limit_price(const Order& order) const {
+    int ticks = order.get_protection_ticks();
+
+    if (order.get_side() == Side::BUY) {
+        if (ticks <= 0) {
+            return Price::fromRaw(std::numeric_limits<int64_t>::max());
+        }
+        return tick_table_.offset(get_best_ask(), ticks);
+    }
+
+    if (ticks <= 0) {
+        return Price::fromRaw(1);
+    }
+    Price limit = tick_table_.offset(get_best_bid(), -ticks);
+    return limit.raw_value() > 0 ? limit : Price::fromRaw(1);
+}
+
+template <typename MatchingPolicy>
+Order* BasicOrderbook<MatchingPolicy>::allocate_order(const Order& order) {
+	Order* new_order = order_pool_.allocate();
+
+	// Copy order data, intrusive links start detached
+	new (new_order) Order(order);
+	new_order->next = nullptr;
+	new_order->prev = nullptr;
+	new_order->level = nullptr;
+	new_order->timer_next = nullptr;
+	new_order->timer_prev = nullptr;
+	new_order->timer_slot = -1;
+	new_order->participant_next = nullptr;
+	new_order->participant_prev = nullptr;
+
+	// DAY orders take the session end as their expiry
+	if (has_expiry(order)) {
+		new_order->set_expire_time(expire_time_of(order));
+	}
+
+	return new_order;
+}
+
+template <typename MatchingPolicy>
+void BasicOrderbook<MatchingPolicy>::add_order_to_book(Order* order) {
     PriceLevel* level = nullptr;
     
     if (order->get_side() == Side::BUY) {
-        level = bid_levels_.find_level(price);
+        level = bid_levels_.find_level(order->tick);
         if (!level) {
-            level = bid_levels_.create_level(price);
+            level = bid_levels_.create_level(order->get_price(), order->tick);
         }
+        bid_levels_.add_order(level, order);
     } else {
-        level = ask_levels_.find_level(price);
+        level = ask_levels_.find_level(order->tick);
         if (!level) {
-            level = ask_levels_.create_level(price);
+            level = ask_levels_.create_level(order->get_price(), order->tick);
         }
+        ask_levels_.add_order(level, order);
     }
-    
-    level->add_order(order);
 }
 
-std::vector<BookLevel> Orderbook::get_bid_levels(int depth) const {
+template <typename MatchingPolicy>
+std::vector<BookLevel> BasicOrderbook<MatchingPolicy>::get_bid_levels(int depth) const {
     std::vector<BookLevel> result;
     result.reserve(depth);
     
@@ -355,7 +1112,8 @@ std::vector<BookLevel> Orderbook::get_bid_levels(int depth) const {
     return result;
 }
 
-std::vector<BookLevel> Orderbook::get_ask_levels(int depth) const {
+template <typename MatchingPolicy>
+std::vector<BookLevel> BasicOrderbook<MatchingPolicy>::get_ask_levels(int depth) const {
     std::vector<BookLevel> result;
     result.reserve(depth);
     
@@ -377,7 +1135,8 @@ std::vector<BookLevel> Orderbook::get_ask_levels(int depth) const {
     return result;
 }
 
-Price Orderbook::get_mid_price() const {
+template <typename MatchingPolicy>
+Price BasicOrderbook<MatchingPolicy>::get_mid_price() const {
     Price best_bid = get_best_bid();
     Price best_ask = get_best_ask();
     
@@ -388,7 +1147,8 @@ Price Orderbook::get_mid_price() const {
     return (best_bid + best_ask) / 2;
 }
 
-Price Orderbook::get_best_bid() const {
+template <typename MatchingPolicy>
+Price BasicOrderbook<MatchingPolicy>::get_best_bid() const {
 	if (bid_levels_.empty()) {
 		return Price(0);
 	}
@@ -396,7 +1156,8 @@ Price Orderbook::get_best_bid() const {
 	return bid_levels_.get_best_level()->get_price();
 }
 
-Price Orderbook::get_best_ask() const {
+template <typename MatchingPolicy>
+Price BasicOrderbook<MatchingPolicy>::get_best_ask() const {
     if (ask_levels_.empty()) {
         return Price(0); // No asks
     }
@@ -404,37 +1165,155 @@ Price Orderbook::get_best_ask() const {
     return ask_levels_.get_best_level()->get_price();
 }
 
-int Orderbook::get_volume_at_price(const Price& price, Side side) const {
+template <typename MatchingPolicy>
+int BasicOrderbook<MatchingPolicy>::get_volume_at_price(const Price& price, Side side) const {
+    // Nothing rests off the grid
+    if (!tick_table_.is_valid(price)) {
+        return 0;
+    }
+    int64_t tick = tick_table_.to_index(price);
     if (side == Side::BUY) {
-		PriceLevel* level = bid_levels_.find_level(price);
+		PriceLevel* level = bid_levels_.find_level(tick);
 		return level ? level->get_total_volume() : 0;
     } else {
-		PriceLevel* level = ask_levels_.find_level(price);
+		PriceLevel* level = ask_levels_.find_level(tick);
 		return level ? level->get_total_volume() : 0;
     }
 }
 
-size_t Orderbook::price_level_count() const {
-    size_t count = 0;
-    
-    // Count bid levels
-    PriceLevel* bid_level = bid_levels_.begin();
-    while (bid_level) {
-        count++;
-        bid_level = bid_levels_.next(bid_level);
+template <typename MatchingPolicy>
+size_t BasicOrderbook<MatchingPolicy>::price_level_count() const {
+    return static_cast<size_t>(bid_levels_.level_count() + ask_levels_.level_count());
+}
+
+template <typename MatchingPolicy>
+BookStats BasicOrderbook<MatchingPolicy>::stats() const {
+    BookStats stats;
+    stats.bids = bid_levels_.stats();
+    stats.asks = ask_levels_.stats();
+    stats.orders = order_map_.size();
+    stats.trades = trade_count_;
+    stats.order_pool_used = order_pool_.total_used();
+    stats.order_pool_capacity = order_pool_.total_capacity();
+    stats.level_pool_used = level_pool_.total_used();
+    stats.level_pool_capacity = level_pool_.total_capacity();
+    return stats;
+}
+
+template <typename MatchingPolicy>
+BookSignals BasicOrderbook<MatchingPolicy>::signals() const {
+    BookSignals signals;
+    signals.bid_levels = bid_levels_.top_level_count();
+    signals.ask_levels = ask_levels_.top_level_count();
+    std::copy(bid_levels_.top_depth(), bid_levels_.top_depth() + SIGNAL_DEPTH, signals.bid_depth);
+    std::copy(ask_levels_.top_depth(), ask_levels_.top_depth() + SIGNAL_DEPTH, signals.ask_depth);
+
+    if (signals.bid_levels > 0) {
+        signals.best_bid = bid_levels_.get_best_level()->get_price();
     }
-    
-    // Count ask levels
-    PriceLevel* ask_level = ask_levels_.begin();
-    while (ask_level) {
-        count++;
-        ask_level = ask_levels_.next(ask_level);
+    if (signals.ask_levels > 0) {
+        signals.best_ask = ask_levels_.get_best_level()->get_price();
     }
-    
-    return count;
+
+    int64_t bid_size = signals.bid_depth[0];
+    int64_t ask_size = signals.ask_depth[0];
+    if (signals.bid_levels > 0 && signals.ask_levels > 0 && bid_size + ask_size > 0) {
+        // The bid is pulled towards the ask by bid size and vice versa
+        int64_t total = bid_size + ask_size;
+        signals.microprice = Price::fromRaw(
+            (signals.best_bid.raw_value() * ask_size + signals.best_ask.raw_value() * bid_size) / total);
+        signals.imbalance_bp = static_cast<int32_t>((bid_size - ask_size) * 10000 / total);
+    }
+    return signals;
+}
+
+template <typename MatchingPolicy>
+BookMemoryStats BasicOrderbook<MatchingPolicy>::memory_stats() const {
+    return BookMemoryStats{order_pool_.stats(), level_pool_.stats()};
+}
+
+template <typename MatchingPolicy>
+size_t BasicOrderbook<MatchingPolicy>::trim_memory(size_t spare_blocks) {
+    size_t released = order_pool_.trim(spare_blocks) + level_pool_.trim(spare_blocks);
+    order_map_.rehash(0);
+    bid_levels_.shrink_lookup();
+    ask_levels_.shrink_lookup();
+    return released;
+}
+
+template <typename MatchingPolicy>
+size_t BasicOrderbook<MatchingPolicy>::compaction_point(double empty_fraction, size_t spare_blocks) {
+    auto mostly_empty = [&](const memory::PoolStats& stats) {
+        return stats.empty_blocks > spare_blocks &&
+               static_cast<double>(stats.empty_blocks) >= empty_fraction * static_cast<double>(stats.blocks);
+    };
+    if (!mostly_empty(order_pool_.stats()) && !mostly_empty(level_pool_.stats())) {
+        return 0;
+    }
+    return trim_memory(spare_blocks);
+}
+
+template <typename MatchingPolicy>
+int64_t BasicOrderbook<MatchingPolicy>::cumulative_volume(Side side, const Price& price) const {
+    // Off-grid prices round towards the worse side: up for bids, down for asks
+    int64_t tick = tick_table_.to_index(price);
+    if (side == Side::BUY) {
+        if (tick_table_.from_index(tick) != price) {
+            tick++;
+        }
+        return bid_levels_.volume_through(tick);
+    }
+    return ask_levels_.volume_through(tick);
 }
 
-void Orderbook::print_book() const {
+template <typename MatchingPolicy>
+Price BasicOrderbook<MatchingPolicy>::price_for_volume(Side side, int64_t volume) const {
+    return tick_table_.from_index((side == Side::BUY ? bid_levels_ : ask_levels_).tick_reaching(volume));
+}
+
+template <typename MatchingPolicy>
+int64_t BasicOrderbook<MatchingPolicy>::volume_within_ticks(Side side, int ticks) const {
+    const PriceLevelList& levels = side == Side::BUY ? bid_levels_ : ask_levels_;
+    if (levels.empty() || ticks < 0) {
+        return 0;
+    }
+    int64_t best = levels.get_best_level()->get_tick();
+    return levels.volume_through(side == Side::BUY ? best - ticks : best + ticks);
+}
+
+template <typename MatchingPolicy>
+metrics::LatencySummary BasicOrderbook<MatchingPolicy>::latency_summary(BookOperation op) const {
+#if ORDERBOOK_LATENCY_STATS
+    return latency_ ? (*latency_)[static_cast<size_t>(op)].summary() : metrics::LatencySummary();
+#else
+    (void)op;
+    return metrics::LatencySummary();
+#endif
+}
+
+template <typename MatchingPolicy>
+void BasicOrderbook<MatchingPolicy>::reset_latency_stats() {
+#if ORDERBOOK_LATENCY_STATS
+    if (latency_) {
+        for (auto& histogram : *latency_) {
+            histogram.reset();
+        }
+    }
+#endif
+}
+
+#if ORDERBOOK_LATENCY_STATS
+template <typename MatchingPolicy>
+metrics::LatencyHistogram& BasicOrderbook<MatchingPolicy>::latency_histogram(BookOperation op) {
+    if (!latency_) {
+        latency_ = std::make_unique<LatencyHistograms>();
+    }
+    return (*latency_)[static_cast<size_t>(op)];
+}
+#endif
+
+template <typename MatchingPolicy>
+void BasicOrderbook<MatchingPolicy>::print_book() const {
     std::cout << "--------- ORDER BOOK ---------" << std::endl;
     std::cout << "ASKS:" << std::endl;
     std::cout << std::setw(10) << "Price" << " | " 
@@ -471,23 +1350,98 @@ void Orderbook::print_book() const {
 
 
 // Helper methods
-bool Orderbook::is_valid_order(const Order& order) const {
+template <typename MatchingPolicy>
+bool BasicOrderbook<MatchingPolicy>::is_valid_order(const Order& order) const {
     // Check for valid volume
 	if (order.get_volume() <= 0) {
         return false;
     }
     
-    // Check for valid price
-    if (order.get_price().raw_value() <= 0) {
+    // Check for valid price - market and stop orders take theirs from the book
+    bool needs_limit = order.get_order_type() == OrderType::LIMIT ||
+                       order.get_order_type() == OrderType::STOP_LIMIT;
+    if (needs_limit && !tick_table_.is_valid(order.get_price())) {
+        return false;
+    }
+
+    if (is_stop_order(order) && !tick_table_.is_valid(order.get_stop_price())) {
+        return false;
+    }
+
+    // Expiring orders need something to expire at
+    if (has_expiry(order) && expire_time_of(order).time_since_epoch().count() <= 0) {
+        return false;
+    }
+
+    // Reserve is derived from the order volume on entry
+    if (order.get_peak_size() < 0 || order.get_hidden_volume() != 0) {
         return false;
     }
     
     return true;
 }
 
-bool Orderbook::has_duplicate_id(const Order& order) const {
+template <typename MatchingPolicy>
+bool BasicOrderbook<MatchingPolicy>::can_fill_completely(const Order& order, const Price& limit) const {
+    int64_t needed = order.get_volume();
+    int64_t limit_tick = tick_table_.to_index(limit);
+    bool buy = order.get_side() == Side::BUY;
+    const PriceLevelList& levels = buy ? ask_levels_ : bid_levels_;
+
+    for (PriceLevel* level = levels.begin(); level; level = levels.next(level)) {
+        if (buy ? level->get_tick() > limit_tick : level->get_tick() < limit_tick) break;
+
+        if (!stp_applies(&order)) {
+            needed -= level->get_executable_volume();
+            if (needed <= 0) return true;
+            continue;
+        }
+
+        // With self-trade prevention on, the taker's own resting orders are not
+        // liquidity. CANCEL_OLDEST removes them and matching carries on; every
+        // other mode stops the fill (or shrinks it) at the first one, and the
+        // policy decides where in the level that falls, so the level holding it
+        // counts for nothing.
+        int64_t available = 0;
+        for (const Order* resting = level->head; resting; resting = resting->next) {
+            if (resting->get_participant_id() != order.get_participant_id()) {
+                available += static_cast<int64_t>(resting->get_volume()) + resting->get_hidden_volume();
+            } else if (stp_mode_ != SelfTradePrevention::CANCEL_OLDEST) {
+                return false;
+            }
+        }
+        needed -= available;
+        if (needed <= 0) return true;
+    }
+
+    return false;
+}
+
+template <typename MatchingPolicy>
+bool BasicOrderbook<MatchingPolicy>::has_duplicate_id(const Order& order) const {
     return order_map_.find(order.get_order_id()) != order_map_.end();
 }
 
+template <typename MatchingPolicy>
+void BasicOrderbook<MatchingPolicy>::aggregate_fill(const Order* aggressor, const Price& price, int volume) {
+    auto since_epoch = aggressor->get_timestamp().time_since_epoch();
+    aggregator_->on_fill(price, volume, static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(since_epoch).count()));
 }
 
+template <typename MatchingPolicy>
+void BasicOrderbook<MatchingPolicy>::chain_output(int order_id, const Price& price, int volume, bool is_buy) {
+    uint64_t h = output_hash_;
+    h = BookChecksum::mix(h ^ static_cast<uint64_t>(static_cast<uint32_t>(order_id)));
+    h = BookChecksum::mix(h ^ static_cast<uint64_t>(price.raw_value()));
+    h = BookChecksum::mix(h ^ (static_cast<uint64_t>(static_cast<uint32_t>(volume)) << 1) ^
+                          (is_buy ? 1 : 0));
+    output_hash_ = h;
+}
+
+// Instantiate the book for every shipped matching policy
+template class BasicOrderbook<FifoMatching>;
+template class BasicOrderbook<ProRataMatching>;
+template class BasicOrderbook<FifoLmmMatching>;
+
+}
@@ -0,0 +1,48 @@
+#include "../../include/orderbook/ParticipantIndex.h"
+
+namespace trading {
+
+void ParticipantIndex::link(Order* order) {
+    int participant_id = order->get_participant_id();
+    if (participant_id == 0) {
+        return;
+    }
+
+    Order*& head = heads_[participant_id];
+    order->participant_prev = nullptr;
+    order->participant_next = head;
+    if (head) {
+        head->participant_prev = order;
+    }
+    head = order;
+}
+
+void ParticipantIndex::unlink(Order* order) {
+    if (order->get_participant_id() == 0) {
+        return;
+    }
+
+    if (order->participant_prev) {
+        order->participant_prev->participant_next = order->participant_next;
+    } else {
+        auto it = heads_.find(order->get_participant_id());
+        if (it == heads_.end() || it->second != order) {
+            return;     // not linked
+        }
+        // Empty lists keep their map entry so reconnecting participants don't allocate
+        it->second = order->participant_next;
+    }
+
+    if (order->participant_next) {
+        order->participant_next->participant_prev = order->participant_prev;
+    }
+    order->participant_next = nullptr;
+    order->participant_prev = nullptr;
+}
+
+Order* ParticipantIndex::head(int participant_id) const {
+    auto it = heads_.find(participant_id);
+    return it != heads_.end() ? it->second : nullptr;
+}
+
+}
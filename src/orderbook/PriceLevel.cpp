@@ -1,10 +1,14 @@
 #include "../../include/orderbook/PriceLevel.h"
+#include <algorithm>
+#include <utility>
 
 namespace trading {
 
-PriceLevel::PriceLevel(const Price& price) :
+PriceLevel::PriceLevel(const Price& price, int64_t tick) :
     price_(price),
+    tick_(tick),
     total_volume_(0),
+    hidden_volume_(0),
     order_count_(0),
     head(nullptr),
     tail(nullptr),
@@ -20,6 +24,10 @@ int PriceLevel::get_total_volume() const {
     return total_volume_;
 }
 
+int PriceLevel::get_hidden_volume() const {
+    return hidden_volume_;
+}
+
 int PriceLevel::get_order_count() const {
     return order_count_;
 }
@@ -44,6 +52,7 @@ void PriceLevel::add_order(Order* order) {
     
     // Update level statistics
     total_volume_ += order->get_volume();
+    hidden_volume_ += order->get_hidden_volume();
     order_count_++;
 }
 
@@ -70,6 +79,7 @@ void PriceLevel::remove_order(Order* order) {
     
     // Update level statistics
     total_volume_ -= order->get_volume();
+    hidden_volume_ -= order->get_hidden_volume();
     order_count_--;
     
     // Clear the order's pointers
@@ -88,24 +98,56 @@ void PriceLevel::update_volume(Order* order, int old_volume) {
     total_volume_ = total_volume_ - old_volume + order->get_volume();
 }
 
-PriceLevel* PriceLevelList::find_level(const Price& price) const {
-    auto it = price_map_.find(price);
+void PriceLevel::resize(Order* order, int volume, int hidden_volume) {
+    if (order->level != this) {
+        return;
+    }
+
+    total_volume_ += volume - order->get_volume();
+    hidden_volume_ += hidden_volume - order->get_hidden_volume();
+    order->set_volume(volume);
+    order->set_hidden_volume(hidden_volume);
+}
+
+void PriceLevel::clear() {
+    head = nullptr;
+    tail = nullptr;
+    total_volume_ = 0;
+    hidden_volume_ = 0;
+    order_count_ = 0;
+}
+
+void PriceLevelList::swap(PriceLevelList& other) noexcept {
+    std::swap(head_, other.head_);
+    std::swap(tail_, other.tail_);
+    std::swap(is_bid_side_, other.is_bid_side_);
+    price_map_.swap(other.price_map_);
+    std::swap(checksum_, other.checksum_);
+    std::swap(top_depth_, other.top_depth_);
+    std::swap(top_levels_, other.top_levels_);
+    std::swap(top_boundary_, other.top_boundary_);
+    std::swap(depth_index_, other.depth_index_);
+    std::swap(stats_, other.stats_);
+}
+
+PriceLevel* PriceLevelList::find_level(int64_t tick) const {
+    auto it = price_map_.find(tick);
     if (it != price_map_.end()) {
         return it->second;
     }
     return nullptr;
 }
 
-PriceLevel* PriceLevelList::create_level(const Price& price) {
+PriceLevel* PriceLevelList::create_level(const Price& price, int64_t tick) {
     // Check if level already exists
-    PriceLevel* existing = find_level(price);
+    PriceLevel* existing = find_level(tick);
     if (existing) {
         return existing;
     }
     
     // Create new price level
-    PriceLevel* new_level = pool_.allocate();
-	new (new_level) PriceLevel(price);
+    PriceLevel* new_level = pool_->allocate();
+	new (new_level) PriceLevel(price, tick);
     
     // Insert into the sorted linked list
     if (!head_) {
@@ -124,7 +166,7 @@ PriceLevel* PriceLevelList::create_level(const Price& price) {
         if (is_bid_side_) {
             // For bid side, we want descending order (highest price first)
             while (current && !inserted) {
-                if (price > current->get_price()) {
+                if (tick > current->get_tick()) {
                     // Insert before current
                     new_level->next_price = current;
                     new_level->prev_price = current->prev_price;
@@ -153,7 +195,7 @@ PriceLevel* PriceLevelList::create_level(const Price& price) {
         } else {
             // For ask side, we want ascending order (lowest price first)
             while (current && !inserted) {
-                if (price < current->get_price()) {
+                if (tick < current->get_tick()) {
                     // Insert before current
                     new_level->next_price = current;
                     new_level->prev_price = current->prev_price;
@@ -183,14 +225,18 @@ PriceLevel* PriceLevelList::create_level(const Price& price) {
     }
     
     // Add to price map for fast lookups
-    price_map_[price] = new_level;
+    price_map_[tick] = new_level;
+    checksum_.toggle(level_term(new_level));
+    stats_.levels++;
+    level_changed(new_level, LevelTotals{});
+    ORDERBOOK_TRACE(LEVEL_CREATE, 0, price.raw_value(), 0, 0, is_bid_side_ ? 0 : 1);
     
     return new_level;
 }
 
 void PriceLevelList::remove_level(PriceLevel* level) {
     // Verify level exists in our map
-    auto it = price_map_.find(level->get_price());
+    auto it = price_map_.find(level->get_tick());
     if (it == price_map_.end() || it->second != level) {
         return; // Not in our list
     }
@@ -209,7 +255,21 @@ void PriceLevelList::remove_level(PriceLevel* level) {
     }
     
     // Remove from price map
-    price_map_.erase(level->get_price());
+    price_map_.erase(level->get_tick());
+    checksum_.toggle(level_term(level));
+    ORDERBOOK_TRACE(LEVEL_REMOVE, 0, level->get_price().raw_value(), 0, 0, is_bid_side_ ? 0 : 1);
+
+    // Normally empty by now; whatever is left leaves the totals with it
+    stats_.levels--;
+    stats_.displayed_volume -= level->get_total_volume();
+    stats_.hidden_volume -= level->get_hidden_volume();
+    stats_.orders -= level->get_order_count();
+    if (int64_t remaining = level->get_executable_volume()) {
+        depth_index_.add(level->get_tick(), -remaining);
+    }
+    if (within_top(level->get_tick())) {
+        refresh_top();
+    }
 }
 
 PriceLevel* PriceLevelList::get_best_level() const {
@@ -228,4 +288,151 @@ PriceLevel* PriceLevelList::next(PriceLevel* current) const {
     return current ? current->next_price : nullptr;
 }
 
+uint64_t PriceLevelList::level_term(const PriceLevel* level) const {
+    return BookChecksum::level_term(level->get_price(), level->get_total_volume(),
+                                    level->get_order_count(), is_bid_side_);
+}
+
+uint64_t PriceLevelList::order_term(const Order* order, int volume, int prev_id) const {
+    return BookChecksum::order_term(order->get_order_id(), order->get_price(), volume,
+                                    order->get_hidden_volume(), order->get_side(), prev_id);
+}
+
+void PriceLevelList::add_order(PriceLevel* level, Order* order) {
+    LevelTotals before = totals_of(level);
+    int prev_id = level->tail ? level->tail->get_order_id() : 0;
+    uint64_t old_level = level_term(level);
+
+    level->add_order(order);
+
+    checksum_.toggle(old_level ^ level_term(level));
+    checksum_.toggle(order_term(order, order->get_volume(), prev_id));
+    level_changed(level, before);
+}
+
+void PriceLevelList::remove_order(PriceLevel* level, Order* order) {
+    if (order->level != level) {
+        return;
+    }
+
+    int order_id = order->get_order_id();
+    int prev_id = order->prev ? order->prev->get_order_id() : 0;
+    uint64_t old_level = level_term(level);
+    LevelTotals before = totals_of(level);
+
+    checksum_.toggle(order_term(order, order->get_volume(), prev_id));
+
+    // The order behind this one moves up in the queue
+    if (Order* next = order->next) {
+        checksum_.toggle(order_term(next, next->get_volume(), order_id));
+        checksum_.toggle(order_term(next, next->get_volume(), prev_id));
+    }
+
+    level->remove_order(order);
+
+    checksum_.toggle(old_level ^ level_term(level));
+    level_changed(level, before);
+}
+
+void PriceLevelList::update_volume(PriceLevel* level, Order* order, int old_volume) {
+    if (order->level != level) {
+        return;
+    }
+
+    int prev_id = order->prev ? order->prev->get_order_id() : 0;
+    uint64_t old_level = level_term(level);
+    LevelTotals before = totals_of(level);
+
+    checksum_.toggle(order_term(order, old_volume, prev_id));
+    checksum_.toggle(order_term(order, order->get_volume(), prev_id));
+
+    level->update_volume(order, old_volume);
+
+    checksum_.toggle(old_level ^ level_term(level));
+    level_changed(level, before);
+}
+
+void PriceLevelList::resize(PriceLevel* level, Order* order, int volume, int hidden_volume) {
+    if (order->level != level) {
+        return;
+    }
+
+    int prev_id = order->prev ? order->prev->get_order_id() : 0;
+    uint64_t old_level = level_term(level);
+    LevelTotals before = totals_of(level);
+
+    checksum_.toggle(order_term(order, order->get_volume(), prev_id));
+    level->resize(order, volume, hidden_volume);
+    checksum_.toggle(order_term(order, order->get_volume(), prev_id));
+
+    checksum_.toggle(old_level ^ level_term(level));
+    level_changed(level, before);
+}
+
+void PriceLevelList::clear_level(PriceLevel* level) {
+    LevelTotals before = totals_of(level);
+    uint64_t old_level = level_term(level);
+
+    int prev_id = 0;
+    for (Order* order = level->head; order; order = order->next) {
+        checksum_.toggle(order_term(order, order->get_volume(), prev_id));
+        prev_id = order->get_order_id();
+    }
+
+    level->clear();
+
+    checksum_.toggle(old_level ^ level_term(level));
+    level_changed(level, before);
+}
+
+void PriceLevelList::replenish(PriceLevel* level, Order* order) {
+    remove_order(level, order);
+
+    int refill = std::min(order->get_peak_size(), order->get_hidden_volume());
+    order->set_volume(refill);
+    order->set_hidden_volume(order->get_hidden_volume() - refill);
+
+    add_order(level, order);
+}
+
+void PriceLevelList::index_volume(const PriceLevel* level, int64_t old_volume) {
+    int64_t tick = level->get_tick();
+    if (depth_index_.covers(tick) || depth_index_.beyond_worst_edge(tick)) {
+        depth_index_.add(tick, level->get_executable_volume() - old_volume);
+    } else {
+        rebuild_depth_index();
+    }
+}
+
+void PriceLevelList::rebuild_depth_index() {
+    if (!head_) {
+        depth_index_.clear();
+        return;
+    }
+
+    // Levels are kept best-first, so head and tail bound the ticks present
+    int64_t best = head_->get_tick();
+    int64_t worst = tail_->get_tick();
+    depth_index_.reset(std::min(best, worst), std::max(best, worst), best);
+    for (PriceLevel* level = head_; level; level = level->next_price) {
+        if (int64_t volume = level->get_executable_volume()) {
+            depth_index_.add(level->get_tick(), volume);
+        }
+    }
+}
+
+void PriceLevelList::refresh_top() {
+    int64_t cumulative = 0;
+    int count = 0;
+    for (PriceLevel* level = head_; level && count < SIGNAL_DEPTH; level = level->next_price) {
+        cumulative += level->get_total_volume();
+        top_depth_[count++] = cumulative;
+        top_boundary_ = level->get_tick();
+    }
+    for (int i = count; i < SIGNAL_DEPTH; ++i) {
+        top_depth_[i] = cumulative;
+    }
+    top_levels_ = count;
+}
+
 }
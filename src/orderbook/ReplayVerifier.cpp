@@ -0,0 +1,179 @@
+#include "../../include/orderbook/ReplayVerifier.h"
+#include "../../include/io/Journal.h"
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+
+namespace trading {
+
+template <typename Book>
+OrderResult ReplayVerifier::apply(Book& book, const io::EventRecord& record, std::vector<TradeInfo>& trades,
+                                  const io::EventRecord* extension) {
+    switch (record.type) {
+        case io::EventType::ORDER_PLACED:
+            if (record.flags & io::PLACE_WITH_LEVEL_FILLS) {
+                std::vector<LevelFillInfo> level_fills;
+                return book.place_order(io::order_from_record(record, extension), trades, level_fills);
+            }
+            return book.place_order(io::order_from_record(record, extension), trades);
+        case io::EventType::ORDER_CANCELLED:
+            return book.cancel_order(record.order_id);
+        case io::EventType::ORDER_MODIFIED:
+            return book.modify_order(record.order_id, Price::fromRaw(record.price), record.volume);
+        case io::EventType::MASS_CANCEL:
+            book.mass_cancel(record.aux, io::mass_cancel_filter_from_record(record));
+            return OrderResult::SUCCESS;
+        case io::EventType::AUCTION_STARTED:
+            book.begin_auction();
+            return OrderResult::SUCCESS;
+        case io::EventType::UNCROSSED:
+            book.uncross(trades, Price::fromRaw(record.price));
+            return OrderResult::SUCCESS;
+        case io::EventType::TIME_ADVANCED:
+            book.advance_time(std::chrono::system_clock::time_point{
+                std::chrono::duration_cast<std::chrono::system_clock::duration>(
+                    std::chrono::nanoseconds(record.timestamp_ns))});
+            return OrderResult::SUCCESS;
+        default:
+            return OrderResult::SUCCESS;
+    }
+}
+
+namespace {
+
+io::BookPolicy policy_of(const FifoMatching&) { return io::BookPolicy::FIFO; }
+io::BookPolicy policy_of(const ProRataMatching&) { return io::BookPolicy::PRO_RATA; }
+io::BookPolicy policy_of(const FifoLmmMatching&) { return io::BookPolicy::FIFO_LMM; }
+
+template <typename Book>
+Book make_book(const io::BookConfig& config) {
+    Book book{TickTable(config.tick_bands)};
+    if constexpr (std::is_same_v<Book, FifoLmmOrderbook>) {
+        book.matching_policy().lmm_participant_id = config.lmm_participant_id;
+        book.matching_policy().lmm_percent = config.lmm_percent;
+    }
+    book.set_self_trade_prevention(config.stp_mode);
+    book.set_session_end(config.session_end);
+    book.set_output_hash_chain(true);
+    return book;
+}
+
+bool profiled_operation(io::EventType type, BookOperation& op) {
+    switch (type) {
+        case io::EventType::ORDER_PLACED: op = BookOperation::PLACE; return true;
+        case io::EventType::ORDER_CANCELLED: op = BookOperation::CANCEL; return true;
+        case io::EventType::ORDER_MODIFIED: op = BookOperation::MODIFY; return true;
+        default: return false;
+    }
+}
+
+}
+
+template <typename Book>
+io::BookConfig ReplayVerifier::config_of(const Book& book) {
+    io::BookConfig config;
+    config.policy = policy_of(book.matching_policy());
+    if constexpr (std::is_same_v<Book, FifoLmmOrderbook>) {
+        config.lmm_participant_id = book.matching_policy().lmm_participant_id;
+        config.lmm_percent = book.matching_policy().lmm_percent;
+    }
+    config.stp_mode = book.get_self_trade_prevention();
+    config.session_end = book.get_session_end();
+    config.tick_bands = book.get_tick_table().bands();
+    return config;
+}
+
+ReplayReport ReplayVerifier::verify(const std::vector<io::EventRecord>& journal, BookProfiler* profiler) const {
+    io::BookConfig config;
+    size_t first = io::read_config(journal, config);
+
+    switch (config.policy) {
+        case io::BookPolicy::PRO_RATA: {
+            auto book = make_book<ProRataOrderbook>(config);
+            return replay(book, journal, first, profiler);
+        }
+        case io::BookPolicy::FIFO_LMM: {
+            auto book = make_book<FifoLmmOrderbook>(config);
+            return replay(book, journal, first, profiler);
+        }
+        case io::BookPolicy::FIFO:
+            break;
+    }
+    auto book = make_book<Orderbook>(config);
+    return replay(book, journal, first, profiler);
+}
+
+template <typename Book>
+ReplayReport ReplayVerifier::replay(Book& book, const std::vector<io::EventRecord>& journal, size_t first,
+                                    BookProfiler* profiler) const {
+    ReplayReport report;
+    std::vector<TradeInfo> trades;
+    trades.reserve(256);
+
+    for (size_t i = first; i < journal.size(); ++i) {
+        const io::EventRecord& record = journal[i];
+        if (record.type == io::EventType::ORDER_EXTENSION) {
+            continue;
+        }
+        if (record.type == io::EventType::BOOK_CONFIG || record.type == io::EventType::TICK_BAND) {
+            throw std::runtime_error("replay: book configuration after the start of the journal");
+        }
+
+        if (record.type != io::EventType::CHECKPOINT) {
+            const io::EventRecord* extension = nullptr;
+            if (record.type == io::EventType::ORDER_PLACED && (record.flags & io::PLACE_HAS_EXTENSION) &&
+                i + 1 < journal.size() && journal[i + 1].type == io::EventType::ORDER_EXTENSION) {
+                extension = &journal[i + 1];
+            }
+
+            trades.clear();
+            BookOperation op;
+            if (profiler && profiled_operation(record.type, op)) {
+                profiler->measure(op, [&] { apply(book, record, trades, extension); });
+            } else {
+                apply(book, record, trades, extension);
+            }
+            report.records_applied++;
+            continue;
+        }
+
+        bool checksum_ok = book.checksum() == record.payload;
+        bool output_ok = true;
+        uint64_t expected_output = 0;
+        if (record.flags & io::CHECKPOINT_HAS_OUTPUT_HASH) {
+            std::memcpy(&expected_output, &record.price, sizeof(expected_output));
+            output_ok = book.output_hash() == expected_output;
+        }
+
+        if (!checksum_ok || !output_ok) {
+            report.consistent = false;
+            report.mismatch_sequence = record.sequence;
+            report.expected_checksum = record.payload;
+            report.actual_checksum = book.checksum();
+            report.expected_output_hash = expected_output;
+            report.actual_output_hash = book.output_hash();
+            return report;
+        }
+
+        report.checkpoints_verified++;
+    }
+
+    return report;
+}
+
+ReplayReport ReplayVerifier::verify_file(const std::string& path, BookProfiler* profiler) const {
+    return verify(io::read_journal(path), profiler);
+}
+
+// Instantiate for every shipped book type
+template OrderResult ReplayVerifier::apply(Orderbook&, const io::EventRecord&, std::vector<TradeInfo>&,
+                                           const io::EventRecord*);
+template OrderResult ReplayVerifier::apply(ProRataOrderbook&, const io::EventRecord&, std::vector<TradeInfo>&,
+                                           const io::EventRecord*);
+template OrderResult ReplayVerifier::apply(FifoLmmOrderbook&, const io::EventRecord&, std::vector<TradeInfo>&,
+                                           const io::EventRecord*);
+template io::BookConfig ReplayVerifier::config_of(const Orderbook&);
+template io::BookConfig ReplayVerifier::config_of(const ProRataOrderbook&);
+template io::BookConfig ReplayVerifier::config_of(const FifoLmmOrderbook&);
+
+}
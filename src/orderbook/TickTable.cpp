@@ -0,0 +1,55 @@
+#include "../../include/orderbook/TickTable.h"
+#include <stdexcept>
+#include <utility>
+
+namespace trading {
+
+TickTable::TickTable(Price tick) : TickTable(std::vector<Band>{Band{Price(), tick}}) {}
+
+TickTable::TickTable(const std::vector<Band>& bands) : min_tick_(0) {
+    std::vector<Entry> entries;
+    if (bands.empty() || bands.front().from.raw_value() != 0) {
+        throw std::invalid_argument("tick table must start at price 0");
+    }
+    for (size_t i = 0; i < bands.size(); ++i) {
+        int64_t from = bands[i].from.raw_value();
+        int64_t tick = bands[i].tick.raw_value();
+        if (tick <= 0) {
+            throw std::invalid_argument("tick size must be positive at " + bands[i].from.to_string());
+        }
+        int64_t base_index = 0;
+        if (i > 0) {
+            const Entry& below = entries.back();
+            if (from <= below.from || (from - below.from) % below.tick != 0) {
+                throw std::invalid_argument("band bound " + bands[i].from.to_string() +
+                                            " is not above and on the grid of the previous band");
+            }
+            base_index = below.base_index + (from - below.from) / below.tick;
+        }
+        entries.push_back(Entry{from, tick, base_index});
+        if (min_tick_ == 0 || tick < min_tick_) {
+            min_tick_ = tick;
+        }
+    }
+    bands_ = std::make_shared<const std::vector<Entry>>(std::move(entries));
+}
+
+std::vector<TickTable::Band> TickTable::bands() const {
+    std::vector<Band> result;
+    for (const Entry& band : *bands_) {
+        result.push_back(Band{Price::fromRaw(band.from), Price::fromRaw(band.tick)});
+    }
+    return result;
+}
+
+Price TickTable::from_index(int64_t index) const {
+    const std::vector<Entry>& bands = *bands_;
+    size_t i = bands.size() - 1;
+    while (i > 0 && index < bands[i].base_index) {
+        i--;
+    }
+    const Entry& band = bands[i];
+    return Price::fromRaw(band.from + (index - band.base_index) * band.tick);
+}
+
+}
@@ -0,0 +1,116 @@
+#include "../../include/orderbook/TickVolumeIndex.h"
+
+namespace trading {
+
+namespace {
+
+size_t round_up_pow2(size_t n) {
+    size_t p = 1;
+    while (p < n) p <<= 1;
+    return p;
+}
+
+}
+
+bool TickVolumeIndex::beyond_worst_edge(int64_t tick) const {
+    if (size_ < MAX_TICKS) {
+        return false;
+    }
+    return descending_ ? tick < base_tick_ : tick >= base_tick_ + static_cast<int64_t>(size_);
+}
+
+void TickVolumeIndex::clear() {
+    // An unsized index keeps no tree, so constructing and moving never allocate
+    if (size_ == 0) {
+        tree_.clear();
+    } else {
+        tree_.assign(size_ + 1, 0);
+    }
+    total_ = 0;
+}
+
+void TickVolumeIndex::reset(int64_t lo, int64_t hi, int64_t best) {
+    size_t span = static_cast<size_t>(hi - lo + 1);
+
+    // Room on both sides so a drifting book does not rebuild on every new level
+    size_t want = span > MAX_TICKS ? MAX_TICKS : span * 2;
+    size_t size = round_up_pow2(want > MIN_TICKS ? want : MIN_TICKS);
+    if (size > MAX_TICKS) {
+        size = MAX_TICKS;
+    }
+
+    if (span <= size) {
+        base_tick_ = lo - static_cast<int64_t>((size - span) / 2);
+    } else if (descending_) {
+        base_tick_ = best - static_cast<int64_t>(size) + 1;
+    } else {
+        base_tick_ = best;
+    }
+
+    size_ = size;
+    log_size_ = 0;
+    while ((size_t(1) << log_size_) < size_) log_size_++;
+    clear();
+}
+
+size_t TickVolumeIndex::position_of(int64_t tick) const {
+    int64_t offset = tick - base_tick_;
+    if (offset < 0) offset = 0;
+    if (offset >= static_cast<int64_t>(size_)) offset = static_cast<int64_t>(size_) - 1;
+    return descending_ ? size_ - 1 - static_cast<size_t>(offset) : static_cast<size_t>(offset);
+}
+
+int64_t TickVolumeIndex::tick_at(size_t position) const {
+    int64_t offset = descending_ ? static_cast<int64_t>(size_ - 1 - position) : static_cast<int64_t>(position);
+    return base_tick_ + offset;
+}
+
+void TickVolumeIndex::add(int64_t tick, int64_t delta) {
+    total_ += delta;
+    for (size_t i = position_of(tick) + 1; i <= size_; i += i & (~i + 1)) {
+        tree_[i] += delta;
+    }
+}
+
+int64_t TickVolumeIndex::volume_through(int64_t tick) const {
+    if (size_ == 0) {
+        return 0;
+    }
+
+    // Ticks better than the whole window hold nothing; worse than it, everything
+    int64_t offset = tick - base_tick_;
+    bool before_window = descending_ ? offset >= static_cast<int64_t>(size_) : offset < 0;
+    bool after_window = descending_ ? offset < 0 : offset >= static_cast<int64_t>(size_);
+    if (before_window) {
+        return 0;
+    }
+    if (after_window) {
+        return total_;
+    }
+
+    int64_t sum = 0;
+    for (size_t i = position_of(tick) + 1; i > 0; i -= i & (~i + 1)) {
+        sum += tree_[i];
+    }
+    return sum;
+}
+
+int64_t TickVolumeIndex::tick_reaching(int64_t volume) const {
+    if (volume <= 0 || volume > total_) {
+        return 0;
+    }
+
+    // Largest position whose prefix stays below `volume`; the answer is the next one
+    size_t position = 0;
+    int64_t remaining = volume;
+    for (size_t step = size_t(1) << log_size_; step > 0; step >>= 1) {
+        size_t next = position + step;
+        if (next <= size_ && tree_[next] < remaining) {
+            position = next;
+            remaining -= tree_[next];
+        }
+    }
+    return tick_at(position);
+}
+
+}
@@ -0,0 +1,140 @@
+#include "../../include/orderbook/TimerWheel.h"
+
+namespace trading {
+
+namespace {
+
+constexpr uint64_t SLOT_MASK = TimerWheel::SLOTS - 1;
+constexpr uint64_t WHEEL_SPAN = 1ULL << (TimerWheel::SLOT_BITS * TimerWheel::LEVELS);
+
+}
+
+void TimerWheel::schedule(Order* order, uint64_t expiry_tick) {
+    if (slots_.empty()) {
+        slots_.assign(LEVELS * SLOTS, nullptr);
+    }
+    if (expiry_tick <= current_) {
+        expiry_tick = current_ + 1;
+    }
+    order->timer_expiry = expiry_tick;
+    place(order, expiry_tick);
+    count_++;
+}
+
+void TimerWheel::cancel(Order* order) {
+    if (order->timer_slot < 0) {
+        return;
+    }
+    unlink(order);
+    count_--;
+}
+
+void TimerWheel::advance(uint64_t tick, std::vector<Order*>& expired) {
+    while (current_ < tick) {
+        if (count_ == 0) {
+            current_ = tick;
+            break;
+        }
+
+        // Nothing can fire below the lowest occupied level, so jump to the next
+        // tick at which that level cascades
+        uint64_t next = current_ + 1;
+        if (level_counts_[0] == 0) {
+            int level = 1;
+            while (level < LEVELS - 1 && level_counts_[level] == 0) {
+                level++;
+            }
+            uint64_t block = 1ULL << (SLOT_BITS * level);
+            next = (current_ / block + 1) * block;
+            if (next > tick) {
+                current_ = tick;
+                break;
+            }
+        }
+
+        current_ = next;
+
+        // Cascade from the top so entries can fall through several levels at once
+        for (int level = LEVELS - 1; level > 0; --level) {
+            uint64_t block = 1ULL << (SLOT_BITS * level);
+            if (current_ % block == 0) {
+                cascade(level, current_);
+            }
+        }
+
+        expire_slot(static_cast<int>(current_ & SLOT_MASK), expired);
+    }
+}
+
+void TimerWheel::link(Order* order, int slot) {
+    Order*& head = slots_[slot];
+    order->timer_prev = nullptr;
+    order->timer_next = head;
+    if (head) {
+        head->timer_prev = order;
+    }
+    head = order;
+    order->timer_slot = slot;
+    level_counts_[slot / SLOTS]++;
+}
+
+void TimerWheel::unlink(Order* order) {
+    int slot = order->timer_slot;
+    if (order->timer_prev) {
+        order->timer_prev->timer_next = order->timer_next;
+    } else {
+        slots_[slot] = order->timer_next;
+    }
+    if (order->timer_next) {
+        order->timer_next->timer_prev = order->timer_prev;
+    }
+    order->timer_next = nullptr;
+    order->timer_prev = nullptr;
+    order->timer_slot = -1;
+    level_counts_[slot / SLOTS]--;
+}
+
+void TimerWheel::place(Order* order, uint64_t expiry_tick) {
+    // Cascaded entries may be due on the current tick: delta 0 lands in the
+    // level 0 slot that is expired straight after the cascade
+    uint64_t delta = expiry_tick - current_;
+
+    // Beyond the wheel's span: park in the top level and re-place on cascade
+    if (delta >= WHEEL_SPAN) {
+        expiry_tick = current_ + WHEEL_SPAN - 1;
+        delta = WHEEL_SPAN - 1;
+    }
+
+    int level = 0;
+    while (level < LEVELS - 1 && delta >= (1ULL << (SLOT_BITS * (level + 1)))) {
+        level++;
+    }
+
+    int slot = static_cast<int>((expiry_tick >> (SLOT_BITS * level)) & SLOT_MASK);
+    link(order, level * SLOTS + slot);
+}
+
+void TimerWheel::cascade(int level, uint64_t tick) {
+    int slot = level * SLOTS + static_cast<int>((tick >> (SLOT_BITS * level)) & SLOT_MASK);
+
+    Order* order = slots_[slot];
+    while (order) {
+        Order* next = order->timer_next;
+        unlink(order);
+        place(order, order->timer_expiry);
+        order = next;
+    }
+}
+
+void TimerWheel::expire_slot(int slot, std::vector<Order*>& expired) {
+    Order* order = slots_[slot];
+    while (order) {
+        Order* next = order->timer_next;
+        unlink(order);
+        count_--;
+        expired.push_back(order);
+        order = next;
+    }
+}
+
+}
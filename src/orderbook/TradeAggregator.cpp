@@ -0,0 +1,81 @@
+#include "../../include/orderbook/TradeAggregator.h"
+
+namespace trading {
+
+TradeAggregator::TradeAggregator(const TradeAggregatorConfig& config) :
+    config_(config),
+    ring_(config.ring_capacity)
+{}
+
+void TradeAggregator::open_bar(Bar& bar, BarType type, int64_t price, uint64_t start_ns, uint64_t end_ns) {
+    bar.type = type;
+    bar.start_ns = start_ns;
+    bar.end_ns = end_ns;
+    bar.open = bar.high = bar.low = bar.close = price;
+    bar.volume = 0;
+    bar.notional = 0;
+    bar.trade_count = 0;
+}
+
+void TradeAggregator::add_fill(Bar& bar, int64_t price, int64_t volume) {
+    if (price > bar.high) bar.high = price;
+    if (price < bar.low) bar.low = price;
+    bar.close = price;
+    bar.volume += volume;
+    bar.notional += price * volume;
+    bar.trade_count++;
+}
+
+void TradeAggregator::publish(Bar& bar) {
+    if (bar.trade_count > 0 && !ring_.try_push(bar)) {
+        dropped_++;
+    }
+    bar.trade_count = 0;
+    bar.volume = 0;
+}
+
+void TradeAggregator::on_fill(const Price& price, int volume, uint64_t timestamp_ns) {
+    int64_t raw = price.raw_value();
+
+    session_notional_ += raw * volume;
+    session_volume_ += volume;
+    session_trades_++;
+
+    if (config_.time_bar_ns > 0) {
+        if (time_bar_.trade_count > 0 && timestamp_ns >= time_bar_.end_ns) {
+            publish(time_bar_);
+        }
+        if (time_bar_.trade_count == 0) {
+            uint64_t start = timestamp_ns - timestamp_ns % config_.time_bar_ns;
+            open_bar(time_bar_, BarType::TIME, raw, start, start + config_.time_bar_ns);
+        }
+        add_fill(time_bar_, raw, volume);
+    }
+
+    if (config_.volume_bar_size > 0) {
+        int64_t remaining = volume;
+        while (remaining > 0) {
+            if (volume_bar_.trade_count == 0) {
+                open_bar(volume_bar_, BarType::VOLUME, raw, timestamp_ns, timestamp_ns);
+            }
+            int64_t part = config_.volume_bar_size - volume_bar_.volume;
+            if (part > remaining) {
+                part = remaining;
+            }
+            add_fill(volume_bar_, raw, part);
+            volume_bar_.end_ns = timestamp_ns;
+            remaining -= part;
+
+            if (volume_bar_.volume == config_.volume_bar_size) {
+                publish(volume_bar_);
+            }
+        }
+    }
+}
+
+void TradeAggregator::flush() {
+    publish(time_bar_);
+    publish(volume_bar_);
+}
+
+}
@@ -0,0 +1,205 @@
+#include "../../include/sim/OrderFlowGenerator.h"
+#include "../../include/io/Journal.h"
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <system_error>
+
+namespace trading {
+namespace sim {
+
+OrderFlowGenerator::OrderFlowGenerator(const OrderFlowConfig& config) :
+    config_(config),
+    rng_(config.seed),
+    buffer_(std::max<size_t>(config.buffer_capacity, 1)),
+    next_order_id_(config.first_order_id),
+    batch_first_id_(config.first_order_id),
+    time_ns_(config.start_time_ns),
+    mid_ticks_x2_(2 * config.initial_mid.raw_value() / config.tick_size.raw_value())
+{
+    live_.reserve(config_.max_live_orders);
+
+    // Geometric depth with mean m: P(k) = p (1 - p)^k, p = 1 / (1 + m)
+    if (config_.passive_mean_ticks > 0.0) {
+        passive_log_q_ = std::log1p(-1.0 / (1.0 + config_.passive_mean_ticks));
+    }
+
+    double weights[] = {config_.add_weight, config_.cancel_weight, config_.modify_weight,
+                        config_.aggressive_weight};
+    double total = 0.0;
+    for (size_t i = 0; i < action_cdf_.size(); ++i) {
+        total += std::max(weights[i], 0.0);
+        action_cdf_[i] = total;
+    }
+    for (double& c : action_cdf_) {
+        c /= total > 0.0 ? total : 1.0;
+    }
+
+    int participants = std::max(config_.participants, 1);
+    participant_cdf_.reserve(participants);
+    client_names_.resize(participants);
+    total = 0.0;
+    for (int k = 1; k <= participants; ++k) {
+        total += 1.0 / std::pow(static_cast<double>(k), config_.participant_skew);
+        participant_cdf_.push_back(total);
+        std::snprintf(client_names_[k - 1].data(), client_names_[k - 1].size(), "P%d", k);
+    }
+    for (double& c : participant_cdf_) {
+        c /= total;
+    }
+}
+
+void OrderFlowGenerator::record_to(const std::string& path) {
+    output_.open(path, std::ios::binary | std::ios::trunc);
+    if (!output_) {
+        throw std::system_error(errno, std::generic_category(), "OrderFlowGenerator: cannot open " + path);
+    }
+}
+
+double OrderFlowGenerator::draw_uniform() {
+    // 53 random bits -> [0, 1)
+    return static_cast<double>(rng_() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+size_t OrderFlowGenerator::draw_below(size_t n) {
+    // Modulo bias is below n / 2^64, negligible for any realistic n
+    return static_cast<size_t>(rng_() % n);
+}
+
+double OrderFlowGenerator::draw_exponential(double rate) {
+    return -std::log1p(-draw_uniform()) / rate;
+}
+
+int OrderFlowGenerator::draw_passive_depth() {
+    if (passive_log_q_ == 0.0) {
+        return 0;
+    }
+    return static_cast<int>(std::log1p(-draw_uniform()) / passive_log_q_);
+}
+
+OrderFlowGenerator::Action OrderFlowGenerator::draw_action() {
+    double u = draw_uniform();
+    for (size_t i = 0; i < action_cdf_.size(); ++i) {
+        if (u < action_cdf_[i]) {
+            return static_cast<Action>(i);
+        }
+    }
+    return Action::ADD;
+}
+
+int OrderFlowGenerator::draw_volume() {
+    int span = std::max(config_.max_volume - config_.min_volume, 0) + 1;
+    return config_.min_volume + static_cast<int>(draw_below(static_cast<size_t>(span)));
+}
+
+size_t OrderFlowGenerator::draw_participant() {
+    double u = draw_uniform();
+    auto it = std::upper_bound(participant_cdf_.begin(), participant_cdf_.end(), u);
+    return std::min(static_cast<size_t>(it - participant_cdf_.begin()), participant_cdf_.size() - 1);
+}
+
+void OrderFlowGenerator::advance_clock() {
+    if (config_.arrivals == ArrivalProcess::POISSON) {
+        time_s_ += draw_exponential(config_.base_rate);
+    } else {
+        // Ogata thinning: the intensity only decays between events, so its value
+        // now bounds it until the next candidate
+        while (true) {
+            double bound = config_.base_rate + hawkes_excess_;
+            double wait = draw_exponential(bound);
+            time_s_ += wait;
+            hawkes_excess_ *= std::exp(-config_.hawkes_decay * wait);
+            if (draw_uniform() * bound <= config_.base_rate + hawkes_excess_) {
+                hawkes_excess_ += config_.branching_ratio * config_.hawkes_decay;
+                break;
+            }
+        }
+    }
+    time_ns_ = config_.start_time_ns + static_cast<uint64_t>(std::llround(time_s_ * 1e9));
+}
+
+void OrderFlowGenerator::begin_batch(const Price& mid) {
+    if (mid.raw_value() > 0) {
+        mid_ticks_x2_ = 2 * mid.raw_value() / config_.tick_size.raw_value();
+    }
+    batch_first_id_ = next_order_id_;
+    batch_size_ = 0;
+}
+
+void OrderFlowGenerator::end_batch() {
+    if (output_.is_open()) {
+        output_.write(reinterpret_cast<const char*>(buffer_.data()),
+                      static_cast<std::streamsize>(batch_size_ * sizeof(io::EventRecord)));
+        if (!output_) {
+            throw std::system_error(errno, std::generic_category(), "OrderFlowGenerator: write failed");
+        }
+    }
+}
+
+void OrderFlowGenerator::drop_live(size_t index) {
+    live_[index] = live_.back();
+    live_.pop_back();
+}
+
+int64_t OrderFlowGenerator::passive_price(Side side) {
+    int64_t depth = draw_passive_depth();
+    int64_t ticks = side == Side::BUY ? mid_ticks_x2_ / 2 - depth : (mid_ticks_x2_ + 1) / 2 + depth;
+    return std::max<int64_t>(ticks, 1) * config_.tick_size.raw_value();
+}
+
+int64_t OrderFlowGenerator::aggressive_price(Side side) {
+    int64_t reach = static_cast<int64_t>(draw_below(static_cast<size_t>(std::max(config_.aggressive_max_ticks, 0)) + 1));
+    int64_t ticks = side == Side::BUY ? (mid_ticks_x2_ + 1) / 2 + reach : mid_ticks_x2_ / 2 - reach;
+    return std::max<int64_t>(ticks, 1) * config_.tick_size.raw_value();
+}
+
+void OrderFlowGenerator::emit(io::EventRecord& record, Action action, size_t target) {
+    advance_clock();
+    uint64_t sequence = sequence_++;
+
+    // Keep the live set bounded: past the cap adds turn into cancels
+    if (action == Action::ADD && live_.size() >= config_.max_live_orders && !live_.empty()) {
+        action = Action::CANCEL;
+        target = draw_below(live_.size());
+    }
+
+    switch (action) {
+        case Action::CANCEL:
+            record = io::make_cancel_record(sequence, live_[target].order_id);
+            drop_live(target);
+            break;
+        case Action::MODIFY:
+            record = io::make_modify_record(sequence, live_[target].order_id,
+                                            Price::fromRaw(passive_price(live_[target].side)), draw_volume());
+            break;
+        case Action::ADD:
+        case Action::AGGRESSIVE: {
+            // Same encoding as io::make_place_record, without building an Order
+            Side side = (rng_() & 1) ? Side::SELL : Side::BUY;
+            bool aggressive = action == Action::AGGRESSIVE;
+            const auto& client = client_names_[draw_participant()];
+
+            std::memset(&record, 0, sizeof(record));
+            record.sequence = sequence;
+            record.type = io::EventType::ORDER_PLACED;
+            record.order_id = next_order_id_++;
+            record.price = aggressive ? aggressive_price(side) : passive_price(side);
+            record.volume = draw_volume();
+            record.side = side == Side::BUY ? 0 : 1;
+            record.flags = static_cast<uint8_t>(aggressive ? TimeInForce::IOC : TimeInForce::GTC);
+            record.order_type = static_cast<uint8_t>(OrderType::LIMIT);
+            record.set_client(client.data(), strnlen(client.data(), client.size()));
+
+            if (!aggressive) {
+                live_.push_back(LiveOrder{record.order_id, side});
+            }
+            break;
+        }
+    }
+    record.timestamp_ns = time_ns_;
+}
+
+}
+}
@@ -0,0 +1,272 @@
+#include "../../include/utils/FlightRecorder.h"
+#include "../../include/common/FixedPoint.h"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <iomanip>
+#include <ostream>
+#include <stdexcept>
+#include <system_error>
+#include <unistd.h>
+
+namespace trading {
+namespace trace {
+
+namespace {
+
+// Dump layout: FileHeader, then per thread a RingHeader and its records oldest first
+constexpr char MAGIC[8] = {'O', 'B', 'T', 'R', 'A', 'C', 'E', '1'};
+constexpr uint32_t VERSION = 1;
+
+struct FileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t record_size;
+    double ticks_per_ns;
+};
+
+struct RingHeader {
+    uint32_t thread_index;
+    uint32_t reserved;
+    uint64_t written;
+    uint64_t count;
+};
+
+constexpr size_t MAX_RINGS = 256;
+std::atomic<FlightRecorder*> rings[MAX_RINGS];
+std::atomic<uint32_t> next_thread_index{0};
+
+// Cached so the crash handler never calibrates
+std::atomic<double> ticks_per_ns{1.0};
+
+char crash_path[512];
+const int CRASH_SIGNALS[] = {SIGSEGV, SIGBUS, SIGILL, SIGFPE, SIGABRT};
+
+bool write_all(int fd, const void* data, size_t length) {
+    const char* p = static_cast<const char*>(data);
+    while (length > 0) {
+        ssize_t n = ::write(fd, p, length);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        p += n;
+        length -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+}
+
+// Writes rings with write(2) only, so the same code serves dump_all and the
+// crash handler
+struct RingWriter {
+    static bool write_file(int fd) {
+        FileHeader header{};
+        std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+        header.version = VERSION;
+        header.record_size = sizeof(TraceRecord);
+        header.ticks_per_ns = ticks_per_ns.load(std::memory_order_relaxed);
+        if (!write_all(fd, &header, sizeof(header))) {
+            return false;
+        }
+
+        for (auto& slot : rings) {
+            const FlightRecorder* ring = slot.load(std::memory_order_acquire);
+            if (ring && !write_ring(fd, *ring)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static bool write_ring(int fd, const FlightRecorder& ring) {
+        constexpr size_t mask = FlightRecorder::CAPACITY - 1;
+        uint64_t written = ring.written_;
+        uint64_t count = std::min<uint64_t>(written, FlightRecorder::CAPACITY);
+        RingHeader header{ring.thread_index_, 0, written, count};
+        if (!write_all(fd, &header, sizeof(header))) {
+            return false;
+        }
+
+        // Oldest record first: [start, end of buffer) then [0, start)
+        size_t start = static_cast<size_t>((written - count) & mask);
+        size_t first = std::min<size_t>(static_cast<size_t>(count), FlightRecorder::CAPACITY - start);
+        const TraceRecord* records = ring.records_.get();
+        return write_all(fd, records + start, first * sizeof(TraceRecord)) &&
+               write_all(fd, records, (static_cast<size_t>(count) - first) * sizeof(TraceRecord));
+    }
+};
+
+namespace {
+
+void crash_handler(int signal) {
+    int fd = ::open(crash_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd >= 0) {
+        RingWriter::write_file(fd);
+        ::close(fd);
+    }
+    // SA_RESETHAND restored the default action
+    ::raise(signal);
+}
+
+}
+
+const char* to_string(TraceEvent event) {
+    switch (event) {
+        case TraceEvent::PLACE: return "PLACE";
+        case TraceEvent::CANCEL: return "CANCEL";
+        case TraceEvent::MODIFY: return "MODIFY";
+        case TraceEvent::TRADE: return "TRADE";
+        case TraceEvent::LEVEL_CREATE: return "LEVEL_CREATE";
+        case TraceEvent::LEVEL_REMOVE: return "LEVEL_REMOVE";
+        case TraceEvent::POOL_GROW: return "POOL_GROW";
+        default: return "NONE";
+    }
+}
+
+FlightRecorder::FlightRecorder() :
+    records_(new TraceRecord[CAPACITY]()),
+    thread_index_(next_thread_index.fetch_add(1, std::memory_order_relaxed))
+{
+    ticks_per_ns.store(metrics::TscClock::ticks_per_ns(), std::memory_order_relaxed);
+
+    // Threads beyond MAX_RINGS still record, they are just left out of dumps
+    for (auto& slot : rings) {
+        FlightRecorder* expected = nullptr;
+        if (slot.compare_exchange_strong(expected, this, std::memory_order_acq_rel)) {
+            break;
+        }
+    }
+}
+
+FlightRecorder::~FlightRecorder() {
+    for (auto& slot : rings) {
+        FlightRecorder* expected = this;
+        if (slot.compare_exchange_strong(expected, nullptr, std::memory_order_acq_rel)) {
+            break;
+        }
+    }
+}
+
+std::vector<TraceRecord> FlightRecorder::snapshot() const {
+    uint64_t count = std::min<uint64_t>(written_, CAPACITY);
+    std::vector<TraceRecord> result;
+    result.reserve(static_cast<size_t>(count));
+    for (uint64_t i = written_ - count; i < written_; ++i) {
+        result.push_back(records_[i & (CAPACITY - 1)]);
+    }
+    return result;
+}
+
+void FlightRecorder::dump_all(const std::string& path) {
+    int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        throw std::system_error(errno, std::generic_category(), "FlightRecorder: cannot open " + path);
+    }
+    bool ok = RingWriter::write_file(fd);
+    int error = errno;
+    ::close(fd);
+    if (!ok) {
+        throw std::system_error(error, std::generic_category(), "FlightRecorder: write failed");
+    }
+}
+
+void FlightRecorder::install_crash_handler(const std::string& path) {
+    size_t length = std::min(path.size(), sizeof(crash_path) - 1);
+    std::memcpy(crash_path, path.data(), length);
+    crash_path[length] = '\0';
+
+    struct sigaction action {};
+    action.sa_handler = crash_handler;
+    sigemptyset(&action.sa_mask);
+    action.sa_flags = SA_RESETHAND;
+    for (int signal : CRASH_SIGNALS) {
+        sigaction(signal, &action, nullptr);
+    }
+}
+
+DecodedTrace decode_trace(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        throw std::system_error(errno, std::generic_category(), "decode_trace: cannot open " + path);
+    }
+
+    FileHeader header{};
+    if (!in.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION ||
+        header.record_size != sizeof(TraceRecord)) {
+        throw std::runtime_error("decode_trace: " + path + " is not a flight-recorder dump");
+    }
+
+    DecodedTrace trace;
+    trace.ticks_per_ns = header.ticks_per_ns > 0.0 ? header.ticks_per_ns : 1.0;
+
+    RingHeader ring{};
+    while (in.read(reinterpret_cast<char*>(&ring), sizeof(ring))) {
+        trace.records_lost += ring.written - ring.count;
+        for (uint64_t i = 0; i < ring.count; ++i) {
+            DecodedRecord decoded{ring.thread_index, {}};
+            if (!in.read(reinterpret_cast<char*>(&decoded.record), sizeof(TraceRecord))) {
+                throw std::runtime_error("decode_trace: " + path + " is truncated");
+            }
+            trace.records.push_back(decoded);
+        }
+    }
+
+    // Each ring is already in order; merge them into one timeline
+    std::stable_sort(trace.records.begin(), trace.records.end(),
+                     [](const DecodedRecord& a, const DecodedRecord& b) { return a.record.tsc < b.record.tsc; });
+    return trace;
+}
+
+void print_timeline(const DecodedTrace& trace, std::ostream& out) {
+    if (trace.records_lost > 0) {
+        out << "(" << trace.records_lost << " older records overwritten)\n";
+    }
+    if (trace.records.empty()) {
+        return;
+    }
+
+    uint64_t origin = trace.records.front().record.tsc;
+    for (const DecodedRecord& decoded : trace.records) {
+        const TraceRecord& r = decoded.record;
+        auto ns = static_cast<uint64_t>(static_cast<double>(r.tsc - origin) / trace.ticks_per_ns);
+        out << std::setw(14) << ns << " ns  T" << decoded.thread_index << "  "
+            << std::left << std::setw(13) << to_string(r.event) << std::right;
+
+        switch (r.event) {
+            case TraceEvent::PLACE:
+            case TraceEvent::MODIFY:
+            case TraceEvent::TRADE:
+                out << " #" << r.order_id << ' ' << (r.side == 0 ? "BUY " : "SELL ") << r.volume << " @ "
+                    << Price::fromRaw(r.price).to_string();
+                if (r.event == TraceEvent::TRADE) {
+                    out << " vs #" << r.aux;
+                }
+                break;
+            case TraceEvent::CANCEL:
+                out << " #" << r.order_id;
+                break;
+            case TraceEvent::LEVEL_CREATE:
+            case TraceEvent::LEVEL_REMOVE:
+                out << ' ' << (r.side == 0 ? "BID " : "ASK ") << Price::fromRaw(r.price).to_string();
+                break;
+            case TraceEvent::POOL_GROW:
+                out << " blocks=" << r.aux << " objects/block=" << r.volume;
+                break;
+            default:
+                break;
+        }
+        out << '\n';
+    }
+}
+
+}
+}
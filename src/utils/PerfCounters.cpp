@@ -0,0 +1,127 @@
+#include "../../include/utils/PerfCounters.h"
+
+#if defined(__linux__) && __has_include(<linux/perf_event.h>)
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define ORDERBOOK_HAS_PERF_EVENTS 1
+#else
+#define ORDERBOOK_HAS_PERF_EVENTS 0
+#endif
+
+namespace trading {
+namespace metrics {
+
+#if ORDERBOOK_HAS_PERF_EVENTS
+
+namespace {
+
+uint64_t cache_config(uint64_t cache, uint64_t op, uint64_t result) {
+    return cache | (op << 8) | (result << 16);
+}
+
+struct EventSpec {
+    uint32_t type;
+    uint64_t config;
+};
+
+constexpr size_t MAX_READ_WORDS = 3 + PERF_EVENT_COUNT;
+
+EventSpec event_spec(PerfEvent event) {
+    switch (event) {
+        case PerfEvent::CYCLES:
+            return {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES};
+        case PerfEvent::INSTRUCTIONS:
+            return {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS};
+        case PerfEvent::L1D_MISSES:
+            return {PERF_TYPE_HW_CACHE, cache_config(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_OP_READ,
+                                                     PERF_COUNT_HW_CACHE_RESULT_MISS)};
+        case PerfEvent::LLC_MISSES:
+            return {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES};
+        case PerfEvent::BRANCH_MISSES:
+            return {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES};
+        case PerfEvent::DTLB_MISSES:
+            return {PERF_TYPE_HW_CACHE, cache_config(PERF_COUNT_HW_CACHE_DTLB, PERF_COUNT_HW_CACHE_OP_READ,
+                                                     PERF_COUNT_HW_CACHE_RESULT_MISS)};
+        default:
+            return {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES};
+    }
+}
+
+int open_event(PerfEvent event, int group_fd) {
+    EventSpec spec = event_spec(event);
+
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = spec.type;
+    attr.config = spec.config;
+    attr.disabled = group_fd < 0 ? 1 : 0;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0));
+}
+
+}
+
+PerfCounterGroup::PerfCounterGroup() {
+    fds_.fill(-1);
+
+    fds_[0] = open_event(PerfEvent::CYCLES, -1);
+    if (fds_[0] < 0) {
+        return;
+    }
+
+    for (size_t i = 1; i < PERF_EVENT_COUNT; ++i) {
+        fds_[i] = open_event(static_cast<PerfEvent>(i), fds_[0]);
+    }
+
+    ioctl(fds_[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(fds_[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+}
+
+PerfCounterGroup::~PerfCounterGroup() {
+    for (int fd : fds_) {
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+}
+
+void PerfCounterGroup::read(PerfSample& sample) const {
+    sample = PerfSample();
+    if (!available()) {
+        return;
+    }
+
+    // { nr, time_enabled, time_running, value[nr] } with values in open order
+    uint64_t buffer[MAX_READ_WORDS];
+    ssize_t bytes = ::read(fds_[0], buffer, sizeof(buffer));
+    if (bytes < static_cast<ssize_t>(3 * sizeof(uint64_t))) {
+        return;
+    }
+
+    sample.time_enabled = buffer[1];
+    sample.time_running = buffer[2];
+    size_t value = 0;
+    for (size_t i = 0; i < PERF_EVENT_COUNT && value < buffer[0]; ++i) {
+        if (fds_[i] >= 0) {
+            sample.values[i] = buffer[3 + value++];
+        }
+    }
+}
+
+#else
+
+PerfCounterGroup::PerfCounterGroup() { fds_.fill(-1); }
+PerfCounterGroup::~PerfCounterGroup() = default;
+void PerfCounterGroup::read(PerfSample& sample) const { sample = PerfSample(); }
+
+#endif
+
+}
+}
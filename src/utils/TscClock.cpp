@@ -0,0 +1,38 @@
+#include "../../include/utils/TscClock.h"
+
+namespace trading {
+namespace metrics {
+
+namespace {
+
+double calibrate() {
+#if ORDERBOOK_HAS_TSC
+    // Spin rather than sleep so the core stays busy and the sample window is exact
+    constexpr auto WINDOW = std::chrono::milliseconds(10);
+    auto wall_start = std::chrono::steady_clock::now();
+    uint64_t tsc_start = TscClock::now();
+
+    auto wall_end = wall_start;
+    while (wall_end - wall_start < WINDOW) {
+        wall_end = std::chrono::steady_clock::now();
+    }
+    uint64_t tsc_end = TscClock::now();
+
+    double ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        wall_end - wall_start).count());
+    double rate = static_cast<double>(tsc_end - tsc_start) / ns;
+    return rate > 0.0 ? rate : 1.0;
+#else
+    return 1.0;
+#endif
+}
+
+}
+
+double TscClock::ticks_per_ns() {
+    static const double rate = calibrate();
+    return rate;
+}
+
+}
+}
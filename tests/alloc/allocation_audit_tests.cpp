@@ -0,0 +1,159 @@
+#define ORDERBOOK_ALLOCATION_HOOKS
+#include "utils/AllocationCounter.h"
+
+#include <gtest/gtest.h>
+#include <random>
+#include "orderbook/Orderbook.h"
+
+using namespace trading;
+
+// Steady-state order entry, cancel, amend and matching must not touch the
+// global heap. Each book is warmed up with the same flow it is then audited
+// on, so pools, lookup tables and scratch vectors have reached their peak.
+
+namespace {
+
+constexpr int LIVE_ORDERS = 2000;
+constexpr int WARMUP_STEPS = 40000;
+constexpr int AUDITED_STEPS = 40000;
+
+enum Step { PLACE, CANCEL, MODIFY, AGGRESS, STEP_COUNT };
+const char* const STEP_NAMES[] = {"place", "cancel", "modify", "aggress"};
+
+template <typename Book>
+class FlowDriver {
+public:
+  explicit FlowDriver(Book& book) : book_(book) {
+    live_.reserve(LIVE_ORDERS * 2);
+    trades_.reserve(1 << 12);
+  }
+
+  // One command; returns its kind and adds the allocations it made to counts
+  void step(uint64_t (&counts)[STEP_COUNT]) {
+    int action = static_cast<int>(gen_() % 100);
+    Step kind = live_.size() < LIVE_ORDERS / 2 || action < 40 ? PLACE
+              : action < 75 ? CANCEL
+              : action < 92 ? MODIFY
+              : AGGRESS;
+    if (kind != PLACE && live_.size() > LIVE_ORDERS) {
+      kind = CANCEL;
+    }
+
+    trades_.clear();
+    bool buy = gen_() & 1;
+    metrics::AllocationScope scope;
+    switch (kind) {
+      case PLACE: {
+        Order order("participant", passive_price(buy), next_id_, volume(), buy ? Side::BUY : Side::SELL, now_);
+        order.set_participant_id(1 + static_cast<int>(gen_() % 8));
+        if (gen_() % 10 == 0) {
+          order.set_peak_size(20);
+        }
+        book_.place_order(order, trades_);
+        live_.push_back(next_id_++);
+        break;
+      }
+      case CANCEL:
+        book_.cancel_order(take_live());
+        break;
+      case MODIFY:
+        book_.modify_order(live_[gen_() % live_.size()], passive_price(buy), volume());
+        break;
+      case AGGRESS: {
+        // Through up to three levels; IOC so nothing rests
+        int64_t reach = static_cast<int64_t>(gen_() % 4) * 100;
+        Price price = Price::fromRaw(buy ? MID + reach : MID - reach);
+        Order order("taker", price, next_id_++, 50 + volume() * 2, buy ? Side::BUY : Side::SELL, now_);
+        order.set_time_in_force(TimeInForce::IOC);
+        book_.place_order(order, trades_);
+        break;
+      }
+      default:
+        break;
+    }
+    counts[kind] += scope.count();
+  }
+
+private:
+  static constexpr int64_t MID = 1000000;
+
+  Book& book_;
+  std::mt19937_64 gen_{7};
+  std::vector<int> live_;
+  std::vector<TradeInfo> trades_;
+  int next_id_ = 1;
+  std::chrono::system_clock::time_point now_ = std::chrono::system_clock::now();
+
+  int volume() { return 1 + static_cast<int>(gen_() % 200); }
+
+  Price passive_price(bool buy) {
+    int64_t depth = 1 + static_cast<int64_t>(gen_() % 40);
+    return Price::fromRaw(buy ? MID - depth * 100 : MID + depth * 100);
+  }
+
+  // Filled orders are skipped rather than tracked
+  int take_live() {
+    size_t k = gen_() % live_.size();
+    int id = live_[k];
+    live_[k] = live_.back();
+    live_.pop_back();
+    return id;
+  }
+};
+
+}
+
+template <typename Book>
+class AllocationAuditTests : public ::testing::Test {};
+
+using AuditedBooks = ::testing::Types<Orderbook, ProRataOrderbook, FifoLmmOrderbook>;
+TYPED_TEST_SUITE(AllocationAuditTests, AuditedBooks);
+
+TYPED_TEST(AllocationAuditTests, SteadyStateFlowDoesNotAllocate) {
+  ASSERT_TRUE(metrics::hooks_installed());
+
+  TypeParam book;
+  FlowDriver<TypeParam> driver(book);
+  uint64_t warmup[STEP_COUNT] = {};
+  for (int i = 0; i < WARMUP_STEPS; ++i) {
+    driver.step(warmup);
+  }
+  // The warm-up itself must have reached the heap, or the hooks are not counting
+  EXPECT_GT(warmup[PLACE], 0u);
+
+  uint64_t audited[STEP_COUNT] = {};
+  for (int i = 0; i < AUDITED_STEPS; ++i) {
+    driver.step(audited);
+  }
+  for (int kind = 0; kind < STEP_COUNT; ++kind) {
+    EXPECT_EQ(audited[kind], 0u) << STEP_NAMES[kind] << " allocated after warm-up";
+  }
+}
+
+TYPED_TEST(AllocationAuditTests, MoveAndSwapDoNotAllocate) {
+  TypeParam book;
+  FlowDriver<TypeParam> driver(book);
+  uint64_t counts[STEP_COUNT] = {};
+  for (int i = 0; i < WARMUP_STEPS; ++i) {
+    driver.step(counts);
+  }
+  uint64_t checksum = book.checksum();
+  TypeParam other;
+
+  metrics::AllocationScope scope;
+  TypeParam moved(std::move(book));
+  moved.swap(other);
+  other.swap(moved);
+  other = std::move(moved);
+  EXPECT_EQ(scope.count(), 0u);
+  EXPECT_EQ(other.checksum(), checksum);
+  EXPECT_EQ(moved.checksum(), 0u);
+}
+
+TEST(AllocationCounterTests, CountsGlobalNew) {
+  metrics::AllocationScope scope;
+  auto* p = new int(3);
+  std::vector<int> v(100);
+  delete p;
+  EXPECT_EQ(scope.count(), 2u);
+}
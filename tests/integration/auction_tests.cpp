@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include "orderbook/Orderbook.h"
+
+using namespace trading;
+
+class AuctionTests : public ::testing::Test {
+protected:
+  Orderbook book;
+  std::vector<TradeInfo> trades;
+  std::chrono::system_clock::time_point now = std::chrono::system_clock::now();
+  int next_id = 1;
+
+  void SetUp() override {
+    book.begin_auction();
+  }
+
+  OrderResult place(const char* price, int volume, Side side) {
+    return book.place_order(Order("c" + std::to_string(next_id), Price(price), next_id++, volume, side, now), trades);
+  }
+};
+
+TEST_F(AuctionTests, OrdersRestCrossedWithoutMatching) {
+  EXPECT_EQ(place("101.0000", 10, Side::BUY), OrderResult::SUCCESS);
+  EXPECT_EQ(place("99.0000", 10, Side::SELL), OrderResult::SUCCESS);
+  EXPECT_TRUE(trades.empty());
+  EXPECT_GT(book.get_best_bid(), book.get_best_ask());
+
+  Order market("m", Price(), next_id++, 5, Side::BUY, now);
+  market.set_order_type(OrderType::MARKET);
+  EXPECT_EQ(book.place_order(market, trades), OrderResult::REJECTED);
+}
+
+TEST_F(AuctionTests, UncrossMaximisesVolume) {
+  place("102.0000", 10, Side::BUY);
+  place("101.0000", 20, Side::BUY);
+  place("100.0000", 30, Side::BUY);
+  place("99.0000", 25, Side::SELL);
+  place("100.0000", 15, Side::SELL);
+  place("101.0000", 20, Side::SELL);
+
+  AuctionResult indicative = book.indicative_uncross();
+  EXPECT_EQ(indicative.price.to_double(), 100.0);
+  EXPECT_EQ(indicative.volume, 40);
+  EXPECT_EQ(indicative.imbalance, 20);
+
+  AuctionResult result = book.uncross(trades);
+  EXPECT_EQ(result.volume, 40);
+  int traded = 0;
+  for (const auto& trade : trades) {
+    EXPECT_EQ(trade.price.to_double(), 100.0);
+    traded += trade.volume;
+  }
+  EXPECT_EQ(traded, 40);
+
+  // Residual book is no longer crossed and trading is continuous again
+  EXPECT_EQ(book.get_trading_phase(), TradingPhase::CONTINUOUS);
+  EXPECT_EQ(book.get_best_bid().to_double(), 100.0);
+  EXPECT_EQ(book.get_volume_at_price(Price("100.0"), Side::BUY), 20);
+  EXPECT_EQ(book.get_best_ask().to_double(), 101.0);
+}
+
+TEST_F(AuctionTests, SurplusSideDecidesBetweenEqualVolumes) {
+  place("101.0000", 20, Side::BUY);
+  place("100.0000", 10, Side::SELL);
+
+  // Volume 10 at both 100 and 101 with buy surplus - the higher price wins
+  AuctionResult result = book.indicative_uncross();
+  EXPECT_EQ(result.price.to_double(), 101.0);
+  EXPECT_EQ(result.imbalance, 10);
+}
+
+TEST_F(AuctionTests, ReferencePriceBreaksBalancedTie) {
+  place("101.0000", 10, Side::BUY);
+  place("100.0000", 10, Side::SELL);
+
+  EXPECT_EQ(book.indicative_uncross(Price("100.9000")).price.to_double(), 101.0);
+  EXPECT_EQ(book.indicative_uncross(Price("100.2000")).price.to_double(), 100.0);
+}
+
+TEST_F(AuctionTests, FillsInTimePriority) {
+  place("100.0000", 10, Side::BUY);
+  place("100.0000", 10, Side::BUY);
+  Order iceberg("hidden", Price("100.0000"), next_id++, 15, Side::SELL, now);
+  iceberg.set_peak_size(5);
+  book.place_order(iceberg, trades);
+
+  AuctionResult result = book.uncross(trades);
+  EXPECT_EQ(result.volume, 15);
+
+  int first = 0, second = 0;
+  for (const auto& trade : trades) {
+    if (trade.order_id == 1) first += trade.volume;
+    if (trade.order_id == 2) second += trade.volume;
+  }
+  EXPECT_EQ(first, 10);
+  EXPECT_EQ(second, 5);
+  EXPECT_EQ(book.get_volume_at_price(Price("100.0"), Side::BUY), 5);
+  EXPECT_EQ(book.get_volume_at_price(Price("100.0"), Side::SELL), 0);
+}
+
+TEST_F(AuctionTests, UncrossWithoutCrossDoesNothing) {
+  place("99.0000", 10, Side::BUY);
+  place("100.0000", 10, Side::SELL);
+
+  AuctionResult result = book.uncross(trades);
+  EXPECT_EQ(result.volume, 0);
+  EXPECT_TRUE(trades.empty());
+  EXPECT_EQ(book.order_count(), 2);
+}
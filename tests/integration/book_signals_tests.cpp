@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+#include <random>
+#include "orderbook/Orderbook.h"
+
+using namespace trading;
+
+class BookSignalsTests : public ::testing::Test {
+protected:
+  Orderbook book;
+  std::vector<TradeInfo> trades;
+
+  // Recomputes the signals from the depth snapshots
+  void expect_consistent() {
+    BookSignals s = book.signals();
+    auto bids = book.get_bid_levels(SIGNAL_DEPTH);
+    auto asks = book.get_ask_levels(SIGNAL_DEPTH);
+
+    ASSERT_EQ(s.bid_levels, static_cast<int>(bids.size()));
+    ASSERT_EQ(s.ask_levels, static_cast<int>(asks.size()));
+    int64_t cumulative = 0;
+    for (int i = 0; i < SIGNAL_DEPTH; ++i) {
+      if (i < static_cast<int>(bids.size())) cumulative += bids[i].total_volume;
+      ASSERT_EQ(s.bid_depth[i], cumulative) << "bid level " << i;
+    }
+    cumulative = 0;
+    for (int i = 0; i < SIGNAL_DEPTH; ++i) {
+      if (i < static_cast<int>(asks.size())) cumulative += asks[i].total_volume;
+      ASSERT_EQ(s.ask_depth[i], cumulative) << "ask level " << i;
+    }
+    EXPECT_EQ(s.best_bid, book.get_best_bid());
+    EXPECT_EQ(s.best_ask, book.get_best_ask());
+  }
+};
+
+TEST_F(BookSignalsTests, MicropriceAndImbalanceAtTouch) {
+  auto now = std::chrono::system_clock::now();
+  book.place_order(Order("b", Price("100.0000"), 1, 300, Side::BUY, now), trades);
+  book.place_order(Order("a", Price("100.1000"), 2, 100, Side::SELL, now), trades);
+
+  BookSignals s = book.signals();
+  // 100.0 * 100/400 + 100.1 * 300/400
+  EXPECT_EQ(s.microprice, Price("100.0750"));
+  EXPECT_EQ(s.imbalance_bp, 5000);
+
+  book.cancel_order(2);
+  s = book.signals();
+  EXPECT_EQ(s.microprice, Price());
+  EXPECT_EQ(s.imbalance_bp, 0);
+  EXPECT_EQ(s.ask_levels, 0);
+}
+
+TEST_F(BookSignalsTests, DepthWindowTracksRandomFlow) {
+  std::mt19937 gen(21);
+  std::uniform_int_distribution<> tick_dist(9950, 10050);
+  std::uniform_int_distribution<> volume_dist(1, 300);
+  std::uniform_int_distribution<> action_dist(0, 9);
+  std::vector<int> live;
+  auto now = std::chrono::system_clock::now();
+  int next_id = 1;
+
+  for (int i = 0; i < 5000; ++i) {
+    int action = action_dist(gen);
+    trades.clear();
+    if (action < 6 || live.empty()) {
+      Side side = gen() & 1 ? Side::BUY : Side::SELL;
+      Order order("c", Price::fromRaw(tick_dist(gen) * 100), next_id, volume_dist(gen), side, now);
+      if (i % 13 == 0) {
+        order.set_peak_size(20);
+      }
+      book.place_order(order, trades);
+      live.push_back(next_id++);
+    } else if (action < 8) {
+      size_t k = gen() % live.size();
+      book.cancel_order(live[k]);
+      live[k] = live.back();
+      live.pop_back();
+    } else {
+      book.modify_order(live[gen() % live.size()], Price::fromRaw(tick_dist(gen) * 100), volume_dist(gen));
+    }
+    expect_consistent();
+    if (HasFatalFailure()) {
+      FAIL() << "diverged at step " << i;
+    }
+  }
+}
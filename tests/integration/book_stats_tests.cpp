@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+#include <random>
+#include "orderbook/Orderbook.h"
+#include "common/SeqLock.h"
+
+using namespace trading;
+
+class BookStatsTests : public ::testing::Test {
+protected:
+  Orderbook book;
+  std::vector<TradeInfo> trades;
+
+  // Recomputes the side totals from full depth snapshots
+  void expect_consistent() {
+    BookStats stats = book.stats();
+    auto check = [&](const SideStats& side, const std::vector<BookLevel>& levels, Side s) {
+      int64_t volume = 0;
+      int orders = 0;
+      for (const auto& level : levels) {
+        volume += level.total_volume;
+        orders += level.order_count;
+      }
+      ASSERT_EQ(side.levels, static_cast<int>(levels.size()));
+      ASSERT_EQ(side.orders, orders);
+      ASSERT_EQ(side.displayed_volume, volume);
+      Price worst = s == Side::BUY ? Price::fromRaw(1) : Price::fromRaw(INT64_MAX);
+      ASSERT_EQ(side.displayed_volume + side.hidden_volume, book.cumulative_volume(s, worst));
+    };
+    check(stats.bids, book.get_bid_levels(1 << 20), Side::BUY);
+    check(stats.asks, book.get_ask_levels(1 << 20), Side::SELL);
+
+    ASSERT_EQ(book.price_level_count(), static_cast<size_t>(stats.bids.levels + stats.asks.levels));
+    ASSERT_EQ(stats.orders, book.order_count());
+    ASSERT_EQ(stats.order_pool_used, book.order_count());
+    ASSERT_EQ(stats.level_pool_used, book.price_level_count());
+  }
+};
+
+TEST_F(BookStatsTests, IcebergReserveIsHidden) {
+  auto now = std::chrono::system_clock::now();
+  Order iceberg("i", Price("100.0000"), 1, 100, Side::SELL, now);
+  iceberg.set_peak_size(10);
+  book.place_order(iceberg, trades);
+  book.place_order(Order("b", Price("99.0000"), 2, 30, Side::BUY, now), trades);
+
+  BookStats stats = book.stats();
+  EXPECT_EQ(stats.asks.levels, 1);
+  EXPECT_EQ(stats.asks.orders, 1);
+  EXPECT_EQ(stats.asks.displayed_volume, 10);
+  EXPECT_EQ(stats.asks.hidden_volume, 90);
+  EXPECT_EQ(stats.bids.displayed_volume, 30);
+  EXPECT_EQ(stats.order_pool_capacity, 1024u);
+
+  book.place_order(Order("t", Price("100.0000"), 3, 15, Side::BUY, now), trades);
+  stats = book.stats();
+  EXPECT_EQ(stats.asks.displayed_volume + stats.asks.hidden_volume, 85);
+  EXPECT_EQ(stats.trades, 2u);
+
+  // Snapshots publish through a SeqLock for readers on other threads
+  concurrency::SeqLock<BookStats> published;
+  published.store(stats);
+  EXPECT_EQ(published.load().asks.hidden_volume, stats.asks.hidden_volume);
+}
+
+TEST_F(BookStatsTests, TracksRandomFlow) {
+  std::mt19937 gen(48);
+  std::uniform_int_distribution<> tick_dist(9950, 10050);
+  std::uniform_int_distribution<> volume_dist(1, 300);
+  std::uniform_int_distribution<> action_dist(0, 9);
+  std::vector<int> live;
+  auto now = std::chrono::system_clock::now();
+  int next_id = 1;
+
+  for (int i = 0; i < 5000; ++i) {
+    int action = action_dist(gen);
+    trades.clear();
+    if (action < 6 || live.empty()) {
+      Side side = gen() & 1 ? Side::BUY : Side::SELL;
+      Order order("c", Price::fromRaw(tick_dist(gen) * 100), next_id, volume_dist(gen), side, now);
+      if (i % 11 == 0) {
+        order.set_peak_size(25);
+      }
+      book.place_order(order, trades);
+      live.push_back(next_id++);
+    } else if (action < 8) {
+      size_t k = gen() % live.size();
+      book.cancel_order(live[k]);
+      live[k] = live.back();
+      live.pop_back();
+    } else {
+      book.modify_order(live[gen() % live.size()], Price::fromRaw(tick_dist(gen) * 100), volume_dist(gen));
+    }
+    expect_consistent();
+    if (HasFatalFailure()) {
+      FAIL() << "diverged at step " << i;
+    }
+  }
+
+  // Level sweeps drop whole queues at once
+  std::vector<LevelFillInfo> fills;
+  book.place_order(Order("sweep", Price::fromRaw(100), next_id++, 1 << 20, Side::SELL, now), trades, fills);
+  expect_consistent();
+  EXPECT_EQ(book.stats().bids.levels, 0);
+}
@@ -0,0 +1,151 @@
+#include <gtest/gtest.h>
+#include <random>
+#include "orderbook/Orderbook.h"
+
+using namespace trading;
+
+class DepthIndexTests : public ::testing::Test {
+protected:
+  Orderbook book;
+  std::vector<TradeInfo> trades;
+  std::chrono::system_clock::time_point now = std::chrono::system_clock::now();
+
+  std::vector<BookLevel> levels(Side side) {
+    return side == Side::BUY ? book.get_bid_levels(1 << 20) : book.get_ask_levels(1 << 20);
+  }
+
+  // Walks the depth snapshot level by level
+  int64_t naive_volume_through(Side side, const Price& price) {
+    int64_t sum = 0;
+    for (const auto& level : levels(side)) {
+      bool within = side == Side::BUY ? level.price >= price : level.price <= price;
+      if (within) sum += level.total_volume;
+    }
+    return sum;
+  }
+
+  Price naive_price_for(Side side, int64_t volume) {
+    int64_t sum = 0;
+    for (const auto& level : levels(side)) {
+      sum += level.total_volume;
+      if (sum >= volume) return level.price;
+    }
+    return Price();
+  }
+
+  void expect_consistent(Side side, std::mt19937& gen) {
+    std::uniform_int_distribution<> price_dist(9900, 10100);
+    for (int i = 0; i < 4; ++i) {
+      Price price = Price::fromRaw(price_dist(gen) * 100);
+      ASSERT_EQ(book.cumulative_volume(side, price), naive_volume_through(side, price))
+          << "at " << price.raw_value();
+    }
+
+    int64_t total = naive_volume_through(side, side == Side::BUY ? Price::fromRaw(1) : Price::fromRaw(INT64_MAX));
+    std::uniform_int_distribution<int64_t> volume_dist(1, total + 10);
+    for (int i = 0; i < 4; ++i) {
+      int64_t volume = volume_dist(gen);
+      ASSERT_EQ(book.price_for_volume(side, volume), naive_price_for(side, volume)) << "for " << volume;
+    }
+  }
+};
+
+TEST_F(DepthIndexTests, CumulativeQueriesOnSmallBook) {
+  book.place_order(Order("b", Price("100.0000"), 1, 100, Side::BUY, now), trades);
+  book.place_order(Order("b", Price("99.9000"), 2, 200, Side::BUY, now), trades);
+  book.place_order(Order("b", Price("99.7000"), 3, 300, Side::BUY, now), trades);
+  book.place_order(Order("a", Price("100.2000"), 4, 50, Side::SELL, now), trades);
+
+  EXPECT_EQ(book.cumulative_volume(Side::BUY, Price("100.1000")), 0);
+  EXPECT_EQ(book.cumulative_volume(Side::BUY, Price("100.0000")), 100);
+  EXPECT_EQ(book.cumulative_volume(Side::BUY, Price("99.8000")), 300);
+  EXPECT_EQ(book.cumulative_volume(Side::BUY, Price("1.0000")), 600);
+  EXPECT_EQ(book.cumulative_volume(Side::SELL, Price("100.1000")), 0);
+  EXPECT_EQ(book.cumulative_volume(Side::SELL, Price("100.2000")), 50);
+
+  EXPECT_EQ(book.price_for_volume(Side::BUY, 100), Price("100.0000"));
+  EXPECT_EQ(book.price_for_volume(Side::BUY, 101), Price("99.9000"));
+  EXPECT_EQ(book.price_for_volume(Side::BUY, 600), Price("99.7000"));
+  EXPECT_EQ(book.price_for_volume(Side::BUY, 601), Price());
+  EXPECT_EQ(book.price_for_volume(Side::SELL, 50), Price("100.2000"));
+
+  // Default tick is 0.01
+  EXPECT_EQ(book.volume_within_ticks(Side::BUY, 0), 100);
+  EXPECT_EQ(book.volume_within_ticks(Side::BUY, 10), 300);
+  EXPECT_EQ(book.volume_within_ticks(Side::BUY, 29), 300);
+  EXPECT_EQ(book.volume_within_ticks(Side::BUY, 30), 600);
+
+  // A partial fill takes volume off the best bid
+  book.place_order(Order("s", Price("100.0000"), 5, 40, Side::SELL, now), trades);
+  EXPECT_EQ(book.cumulative_volume(Side::BUY, Price("100.0000")), 60);
+  EXPECT_EQ(book.price_for_volume(Side::BUY, 61), Price("99.9000"));
+}
+
+TEST_F(DepthIndexTests, IcebergReserveCounts) {
+  Order iceberg("i", Price("100.0000"), 1, 100, Side::SELL, now);
+  iceberg.set_peak_size(10);
+  book.place_order(iceberg, trades);
+  book.place_order(Order("a", Price("100.1000"), 2, 50, Side::SELL, now), trades);
+
+  EXPECT_EQ(book.get_volume_at_price(Price("100.0000"), Side::SELL), 10);
+  EXPECT_EQ(book.cumulative_volume(Side::SELL, Price("100.0000")), 100);
+  EXPECT_EQ(book.price_for_volume(Side::SELL, 100), Price("100.0000"));
+  EXPECT_EQ(book.price_for_volume(Side::SELL, 101), Price("100.1000"));
+
+  // Taking the displayed peak replenishes from the reserve
+  book.place_order(Order("b", Price("100.0000"), 3, 25, Side::BUY, now), trades);
+  EXPECT_EQ(book.cumulative_volume(Side::SELL, Price("100.0000")), 75);
+  EXPECT_EQ(book.cumulative_volume(Side::SELL, Price("100.1000")), 125);
+}
+
+TEST_F(DepthIndexTests, MatchesNaiveWalkUnderRandomFlow) {
+  std::mt19937 gen(44);
+  std::uniform_int_distribution<> tick_dist(9950, 10050);
+  std::uniform_int_distribution<> volume_dist(1, 300);
+  std::uniform_int_distribution<> action_dist(0, 9);
+  std::vector<int> live;
+  int next_id = 1;
+
+  for (int i = 0; i < 4000; ++i) {
+    int action = action_dist(gen);
+    trades.clear();
+    if (action < 6 || live.empty()) {
+      Side side = gen() & 1 ? Side::BUY : Side::SELL;
+      // Occasional far-away orders move the window and force rebuilds
+      int ticks = tick_dist(gen);
+      if (i % 97 == 0) {
+        ticks += side == Side::BUY ? -4000 : 4000;
+      }
+      book.place_order(Order("c", Price::fromRaw(ticks * 100), next_id, volume_dist(gen), side, now), trades);
+      live.push_back(next_id++);
+    } else if (action < 8) {
+      size_t k = gen() % live.size();
+      book.cancel_order(live[k]);
+      live[k] = live.back();
+      live.pop_back();
+    } else {
+      book.modify_order(live[gen() % live.size()], Price::fromRaw(tick_dist(gen) * 100), volume_dist(gen));
+    }
+
+    expect_consistent(Side::BUY, gen);
+    expect_consistent(Side::SELL, gen);
+    if (HasFatalFailure()) {
+      FAIL() << "diverged at step " << i;
+    }
+  }
+}
+
+TEST_F(DepthIndexTests, OutlierBeyondWindowStaysInTotals) {
+  book.place_order(Order("a", Price("100.0000"), 1, 100, Side::SELL, now), trades);
+  book.place_order(Order("a", Price("100.1000"), 2, 100, Side::SELL, now), trades);
+  // Millions of ticks away - lands in the window's last bucket
+  book.place_order(Order("a", Price("500000.0000"), 3, 7, Side::SELL, now), trades);
+
+  EXPECT_EQ(book.cumulative_volume(Side::SELL, Price("100.1000")), 200);
+  EXPECT_EQ(book.cumulative_volume(Side::SELL, Price("600000.0000")), 207);
+  EXPECT_EQ(book.price_for_volume(Side::SELL, 150), Price("100.1000"));
+
+  book.cancel_order(3);
+  EXPECT_EQ(book.cumulative_volume(Side::SELL, Price("600000.0000")), 200);
+  EXPECT_EQ(book.price_for_volume(Side::SELL, 201), Price());
+}
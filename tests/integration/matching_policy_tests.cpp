@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+#include <random>
+#include "orderbook/Orderbook.h"
+
+using namespace trading;
+
+class MatchingPolicyTests : public ::testing::Test {
+protected:
+  std::vector<TradeInfo> trades;
+  std::chrono::system_clock::time_point now = std::chrono::system_clock::now();
+
+  template <typename Book>
+  void rest(Book& book, int id, int volume, int participant = 0) {
+    Order order("r" + std::to_string(id), Price("100.0000"), id, volume, Side::SELL, now);
+    order.set_participant_id(participant);
+    book.place_order(order, trades);
+  }
+};
+
+TEST_F(MatchingPolicyTests, ProRataSharesBySizeAfterTopOrder) {
+  ProRataOrderbook book;
+  rest(book, 1, 10);
+  rest(book, 2, 30);
+  rest(book, 3, 60);
+
+  book.place_order(Order("taker", Price("100.0000"), 4, 40, Side::BUY, now), trades);
+  ASSERT_EQ(trades.size(), 3);
+  EXPECT_EQ(trades[0].counterparty, "r1");
+  EXPECT_EQ(trades[0].volume, 10);
+  EXPECT_EQ(trades[1].volume, 10);
+  EXPECT_EQ(trades[2].volume, 20);
+  EXPECT_EQ(book.get_volume_at_price(Price("100.0"), Side::SELL), 60);
+}
+
+TEST_F(MatchingPolicyTests, ProRataRemainderIsDeterministic) {
+  ProRataOrderbook book;
+  rest(book, 1, 5);
+  rest(book, 2, 1);
+  rest(book, 3, 1);
+  rest(book, 4, 1);
+
+  // 2 lots over three equal orders: cumulative rounding gives them to orders 3 and 4
+  book.place_order(Order("taker", Price("100.0000"), 5, 7, Side::BUY, now), trades);
+  ASSERT_EQ(trades.size(), 3);
+  EXPECT_EQ(trades[1].counterparty, "r3");
+  EXPECT_EQ(trades[2].counterparty, "r4");
+  EXPECT_EQ(book.order_count(), 1);
+}
+
+TEST_F(MatchingPolicyTests, ProRataConservesQuantity) {
+  ProRataOrderbook book;
+  std::mt19937 gen(9);
+  std::uniform_int_distribution<> volume_dist(1, 100);
+
+  int resting = 0;
+  for (int i = 1; i <= 50; ++i) {
+    int volume = volume_dist(gen);
+    rest(book, i, volume);
+    resting += volume;
+  }
+
+  int taken = 0;
+  for (int i = 0; i < 20; ++i) {
+    trades.clear();
+    int volume = volume_dist(gen);
+    book.place_order(Order("taker", Price("100.0000"), 100 + i, volume, Side::BUY, now), trades);
+    int filled = 0;
+    for (const auto& trade : trades) filled += trade.volume;
+    EXPECT_EQ(filled, std::min(volume, resting - taken));
+    taken += filled;
+  }
+  EXPECT_EQ(book.get_volume_at_price(Price("100.0"), Side::SELL), resting - taken);
+}
+
+TEST_F(MatchingPolicyTests, LeadMarketMakerGetsAllocationFirst) {
+  FifoLmmOrderbook book;
+  book.matching_policy().lmm_participant_id = 9;
+  book.matching_policy().lmm_percent = 40;
+
+  rest(book, 1, 50, 1);
+  rest(book, 2, 50, 9);
+
+  book.place_order(Order("taker", Price("100.0000"), 3, 50, Side::BUY, now), trades);
+  ASSERT_EQ(trades.size(), 2);
+  EXPECT_EQ(trades[0].counterparty, "r2");
+  EXPECT_EQ(trades[0].volume, 20);
+  EXPECT_EQ(trades[1].counterparty, "r1");
+  EXPECT_EQ(trades[1].volume, 30);
+}
+
+TEST_F(MatchingPolicyTests, LeadMarketMakerWithoutConfigIsFifo) {
+  FifoLmmOrderbook book;
+  rest(book, 1, 50, 1);
+  rest(book, 2, 50, 9);
+
+  book.place_order(Order("taker", Price("100.0000"), 3, 50, Side::BUY, now), trades);
+  ASSERT_EQ(trades.size(), 1);
+  EXPECT_EQ(trades[0].counterparty, "r1");
+}
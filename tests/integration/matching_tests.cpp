@@ -60,4 +60,479 @@ TEST_F(MatchingTests, ComplexOrderMatching) {
   // Order book should have 1 price level with 1 order
   EXPECT_EQ(book.price_level_count(), 1);
   EXPECT_EQ(book.order_count(), 1);
-}
\ No newline at end of file
+}
+
+TEST_F(MatchingTests, MarketOrderSweepsWithoutResting) {
+  auto now = std::chrono::system_clock::now();
+
+  book.place_order(Order("s1", Price("100.0000"), 1, 20, Side::SELL, now), trades);
+  book.place_order(Order("s2", Price("105.0000"), 2, 20, Side::SELL, now), trades);
+
+  Order market("taker", Price(), 3, 100, Side::BUY, now);
+  market.set_order_type(OrderType::MARKET);
+  auto result = book.place_order(market, trades);
+
+  EXPECT_EQ(result, OrderResult::PARTIAL_FILL);
+  ASSERT_EQ(trades.size(), 2);
+  EXPECT_EQ(trades[0].price.to_double(), 100.0);
+  EXPECT_EQ(trades[1].price.to_double(), 105.0);
+  EXPECT_EQ(book.order_count(), 0);
+  EXPECT_EQ(book.price_level_count(), 0);
+
+  // Nothing left to trade against
+  Order again("taker", Price(), 4, 10, Side::BUY, now);
+  again.set_order_type(OrderType::MARKET);
+  EXPECT_EQ(book.place_order(again, trades), OrderResult::CANCELLED);
+}
+
+TEST_F(MatchingTests, MarketOrderProtectionBand) {
+  auto now = std::chrono::system_clock::now();
+
+  book.place_order(Order("b1", Price("100.00"), 1, 10, Side::BUY, now), trades);
+  book.place_order(Order("b2", Price("99.99"), 2, 10, Side::BUY, now), trades);
+  book.place_order(Order("b3", Price("99.95"), 3, 10, Side::BUY, now), trades);
+
+  // Default tick is 0.01 - two ticks through 100.00 reaches 99.98
+  Order market("taker", Price(), 4, 30, Side::SELL, now);
+  market.set_order_type(OrderType::MARKET);
+  market.set_protection_ticks(2);
+  auto result = book.place_order(market, trades);
+
+  EXPECT_EQ(result, OrderResult::PARTIAL_FILL);
+  ASSERT_EQ(trades.size(), 2);
+  EXPECT_EQ(book.order_count(), 1);
+  EXPECT_EQ(book.get_best_bid().to_string(), "99.9500");
+}
+
+TEST_F(MatchingTests, WholeLevelsReportedAsLevelFills) {
+  auto now = std::chrono::system_clock::now();
+
+  book.place_order(Order("s1", Price("100.0000"), 1, 10, Side::SELL, now), trades);
+  book.place_order(Order("s2", Price("100.0000"), 2, 10, Side::SELL, now), trades);
+  book.place_order(Order("s3", Price("100.0000"), 3, 10, Side::SELL, now), trades);
+  book.place_order(Order("s4", Price("101.0000"), 4, 20, Side::SELL, now), trades);
+  book.place_order(Order("s5", Price("101.0000"), 5, 20, Side::SELL, now), trades);
+
+  std::vector<LevelFillInfo> level_fills;
+  Order market("taker", Price(), 6, 50, Side::BUY, now);
+  market.set_order_type(OrderType::MARKET);
+  auto result = book.place_order(market, trades, level_fills);
+  EXPECT_EQ(result, OrderResult::COMPLETE_FILL);
+
+  // First level swept in bulk, the partially consumed one reported per order
+  ASSERT_EQ(level_fills.size(), 1);
+  EXPECT_EQ(level_fills[0].price.to_double(), 100.0);
+  EXPECT_EQ(level_fills[0].volume, 30);
+  EXPECT_EQ(level_fills[0].order_count, 3);
+  ASSERT_EQ(trades.size(), 1);
+  EXPECT_EQ(trades[0].counterparty, "s4");
+  EXPECT_EQ(trades[0].volume, 20);
+
+  EXPECT_EQ(book.order_count(), 1);
+  EXPECT_EQ(book.price_level_count(), 1);
+
+  Orderbook direct;
+  direct.place_order(Order("s5", Price("101.0000"), 5, 20, Side::SELL, now), trades);
+  EXPECT_EQ(book.checksum(), direct.checksum());
+}
+
+TEST_F(MatchingTests, IcebergDisplaysOnlyPeak) {
+  auto now = std::chrono::system_clock::now();
+
+  Order iceberg("hidden", Price("100.0000"), 1, 100, Side::SELL, now);
+  iceberg.set_peak_size(10);
+  EXPECT_EQ(book.place_order(iceberg, trades), OrderResult::SUCCESS);
+
+  EXPECT_EQ(book.get_volume_at_price(Price("100.0"), Side::SELL), 10);
+  auto asks = book.get_ask_levels(1);
+  ASSERT_EQ(asks.size(), 1);
+  EXPECT_EQ(asks[0].total_volume, 10);
+  EXPECT_EQ(asks[0].order_count, 1);
+}
+
+TEST_F(MatchingTests, IcebergReplenishesAtBackOfQueue) {
+  auto now = std::chrono::system_clock::now();
+
+  Order iceberg("hidden", Price("100.0000"), 1, 30, Side::SELL, now);
+  iceberg.set_peak_size(10);
+  book.place_order(iceberg, trades);
+  book.place_order(Order("plain", Price("100.0000"), 2, 10, Side::SELL, now), trades);
+
+  // Peak is filled, refilled behind the plain order, which trades next
+  book.place_order(Order("buyer", Price("100.0000"), 3, 15, Side::BUY, now), trades);
+  ASSERT_EQ(trades.size(), 2);
+  EXPECT_EQ(trades[0].counterparty, "hidden");
+  EXPECT_EQ(trades[0].volume, 10);
+  EXPECT_EQ(trades[1].counterparty, "plain");
+  EXPECT_EQ(trades[1].volume, 5);
+  EXPECT_EQ(book.get_volume_at_price(Price("100.0"), Side::SELL), 15);
+  EXPECT_EQ(book.order_count(), 2);
+}
+
+TEST_F(MatchingTests, AggressorConsumesHiddenReserve) {
+  auto now = std::chrono::system_clock::now();
+
+  Order iceberg("hidden", Price("100.0000"), 1, 50, Side::SELL, now);
+  iceberg.set_peak_size(10);
+  book.place_order(iceberg, trades);
+
+  auto result = book.place_order(Order("buyer", Price("100.0000"), 2, 35, Side::BUY, now), trades);
+  EXPECT_EQ(result, OrderResult::COMPLETE_FILL);
+  ASSERT_EQ(trades.size(), 4);
+  EXPECT_EQ(trades[3].volume, 5);
+  EXPECT_EQ(book.get_volume_at_price(Price("100.0"), Side::SELL), 5);
+
+  // Fill-or-kill sees the reserve too: 5 displayed + 10 hidden
+  Order fok("buyer", Price("100.0000"), 3, 15, Side::BUY, now);
+  fok.set_time_in_force(TimeInForce::FOK);
+  EXPECT_EQ(book.place_order(fok, trades), OrderResult::COMPLETE_FILL);
+  EXPECT_EQ(book.order_count(), 0);
+  EXPECT_EQ(book.price_level_count(), 0);
+}
+
+TEST_F(MatchingTests, IcebergPriceAmendKeepsReserve) {
+  auto now = std::chrono::system_clock::now();
+
+  Order iceberg("hidden", Price("100.0000"), 1, 100, Side::SELL, now);
+  iceberg.set_peak_size(10);
+  book.place_order(iceberg, trades);
+
+  // The new volume is the total left; the peak is re-derived at the new price
+  EXPECT_EQ(book.modify_order(1, Price("100.0100"), 100), OrderResult::SUCCESS);
+  EXPECT_EQ(book.get_volume_at_price(Price("100.01"), Side::SELL), 10);
+  EXPECT_EQ(book.cumulative_volume(Side::SELL, Price("100.01")), 100);
+
+  auto result = book.place_order(Order("buyer", Price("100.0100"), 2, 100, Side::BUY, now), trades);
+  EXPECT_EQ(result, OrderResult::COMPLETE_FILL);
+  EXPECT_EQ(book.order_count(), 0);
+}
+
+TEST_F(MatchingTests, IcebergDecreaseComesOutOfReserve) {
+  auto now = std::chrono::system_clock::now();
+
+  Order iceberg("hidden", Price("100.0000"), 1, 100, Side::SELL, now);
+  iceberg.set_peak_size(10);
+  book.place_order(iceberg, trades);
+  book.place_order(Order("plain", Price("100.0000"), 2, 10, Side::SELL, now), trades);
+
+  // 100 -> 50 shrinks the reserve and keeps the iceberg first in the queue
+  EXPECT_EQ(book.modify_order(1, Price("100.0000"), 50), OrderResult::SUCCESS);
+  EXPECT_EQ(book.get_volume_at_price(Price("100.0"), Side::SELL), 20);
+  EXPECT_EQ(book.cumulative_volume(Side::SELL, Price("100.0")), 60);
+
+  // Below the peak the reserve is gone and the display shrinks too
+  EXPECT_EQ(book.modify_order(1, Price("100.0000"), 4), OrderResult::SUCCESS);
+  EXPECT_EQ(book.get_volume_at_price(Price("100.0"), Side::SELL), 14);
+
+  book.place_order(Order("buyer", Price("100.0000"), 3, 4, Side::BUY, now), trades);
+  ASSERT_EQ(trades.size(), 1);
+  EXPECT_EQ(trades[0].counterparty, "hidden");
+
+  Orderbook direct;
+  direct.place_order(Order("plain", Price("100.0000"), 2, 10, Side::SELL, now), trades);
+  EXPECT_EQ(book.checksum(), direct.checksum());
+}
+
+TEST_F(MatchingTests, LevelVolumeBeyondIntRange) {
+  auto now = std::chrono::system_clock::now();
+
+  // 1.7e9 displayed and 0.7e9 in reserve: the level's total does not fit an int
+  book.place_order(Order("plain", Price("100.0000"), 1, 1200000000, Side::SELL, now), trades);
+  Order iceberg("hidden", Price("100.0000"), 2, 1200000000, Side::SELL, now);
+  iceberg.set_peak_size(500000000);
+  book.place_order(iceberg, trades);
+
+  // Neither the fill-or-kill check nor the whole-level sweep may take it for less
+  std::vector<LevelFillInfo> level_fills;
+  Order fok("buyer", Price("100.0000"), 3, 2000000000, Side::BUY, now);
+  fok.set_time_in_force(TimeInForce::FOK);
+  EXPECT_EQ(book.place_order(fok, trades, level_fills), OrderResult::COMPLETE_FILL);
+  EXPECT_TRUE(level_fills.empty());
+  ASSERT_EQ(trades.size(), 3);
+  EXPECT_EQ(book.get_volume_at_price(Price("100.0"), Side::SELL), 200000000);
+  EXPECT_EQ(book.cumulative_volume(Side::SELL, Price("100.0")), 400000000);
+}
+
+TEST_F(MatchingTests, StopTriggersOnLastTrade) {
+  auto now = std::chrono::system_clock::now();
+
+  book.place_order(Order("s1", Price("100.0000"), 1, 10, Side::SELL, now), trades);
+  book.place_order(Order("s2", Price("101.0000"), 2, 10, Side::SELL, now), trades);
+
+  Order stop("stopper", Price(), 3, 5, Side::BUY, now);
+  stop.set_order_type(OrderType::STOP);
+  stop.set_stop_price(Price("100.0000"));
+  EXPECT_EQ(book.place_order(stop, trades), OrderResult::SUCCESS);
+  EXPECT_TRUE(trades.empty());
+  EXPECT_EQ(book.get_volume_at_price(Price("100.0"), Side::SELL), 10);
+
+  // A trade at 100 fires the stop, which lifts the rest of the 100 level
+  book.place_order(Order("b1", Price("100.0000"), 4, 5, Side::BUY, now), trades);
+  ASSERT_EQ(trades.size(), 2);
+  EXPECT_EQ(trades[1].order_id, 3);
+  EXPECT_EQ(trades[1].volume, 5);
+  EXPECT_EQ(book.get_best_ask().to_double(), 101.0);
+  EXPECT_EQ(book.order_count(), 1);
+}
+
+TEST_F(MatchingTests, StopLimitRestsAfterTrigger) {
+  auto now = std::chrono::system_clock::now();
+
+  book.place_order(Order("b1", Price("100.0000"), 1, 10, Side::BUY, now), trades);
+
+  Order stop("stopper", Price("99.0000"), 2, 20, Side::SELL, now);
+  stop.set_order_type(OrderType::STOP_LIMIT);
+  stop.set_stop_price(Price("100.0000"));
+  book.place_order(stop, trades);
+
+  book.place_order(Order("s1", Price("100.0000"), 3, 4, Side::SELL, now), trades);
+
+  // Stop-limit takes the remaining 6 at 100 and rests 14 at 99
+  ASSERT_EQ(trades.size(), 2);
+  EXPECT_EQ(trades[1].volume, 6);
+  EXPECT_EQ(book.get_best_ask().to_double(), 99.0);
+  EXPECT_EQ(book.get_volume_at_price(Price("99.0"), Side::SELL), 14);
+}
+
+TEST_F(MatchingTests, StopCascadeRunsInOnePlacement) {
+  auto now = std::chrono::system_clock::now();
+
+  for (int i = 0; i < 5; ++i) {
+    Price price = Price::fromRaw((100 - i) * 10000);
+    book.place_order(Order("b", price, 10 + i, 10, Side::BUY, now), trades);
+  }
+
+  // Each sell stop trades one level lower, which fires the next one
+  for (int i = 0; i < 4; ++i) {
+    Order stop("stopper", Price(), 20 + i, 10, Side::SELL, now);
+    stop.set_order_type(OrderType::STOP);
+    stop.set_stop_price(Price::fromRaw((100 - i) * 10000));
+    book.place_order(stop, trades);
+  }
+  EXPECT_TRUE(trades.empty());
+
+  book.place_order(Order("s", Price("100.0000"), 30, 10, Side::SELL, now), trades);
+  EXPECT_EQ(trades.size(), 5);
+  EXPECT_EQ(book.order_count(), 0);
+  EXPECT_EQ(book.get_last_trade_price().to_double(), 96.0);
+}
+
+TEST_F(MatchingTests, CancelPendingStop) {
+  auto now = std::chrono::system_clock::now();
+
+  Order stop("stopper", Price(), 1, 10, Side::BUY, now);
+  stop.set_order_type(OrderType::STOP);
+  stop.set_stop_price(Price("101.0000"));
+  book.place_order(stop, trades);
+
+  EXPECT_EQ(book.modify_order(1, Price(), 4), OrderResult::SUCCESS);
+  EXPECT_EQ(book.cancel_order(1), OrderResult::SUCCESS);
+  EXPECT_EQ(book.order_count(), 0);
+
+  book.place_order(Order("s1", Price("101.0000"), 2, 10, Side::SELL, now), trades);
+  book.place_order(Order("b1", Price("101.0000"), 3, 5, Side::BUY, now), trades);
+  ASSERT_EQ(trades.size(), 1);
+  EXPECT_EQ(book.get_volume_at_price(Price("101.0"), Side::SELL), 5);
+}
+
+TEST_F(MatchingTests, GoodTillTimeOrdersExpire) {
+  auto now = std::chrono::system_clock::now();
+  book.advance_time(now);
+
+  Order gtt("expiring", Price("100.0000"), 1, 10, Side::BUY, now);
+  gtt.set_time_in_force(TimeInForce::GTT);
+  gtt.set_expire_time(now + std::chrono::seconds(5));
+  EXPECT_EQ(book.place_order(gtt, trades), OrderResult::SUCCESS);
+  book.place_order(Order("plain", Price("100.0000"), 2, 10, Side::BUY, now), trades);
+
+  EXPECT_EQ(book.advance_time(now + std::chrono::seconds(4)), 0u);
+  EXPECT_EQ(book.get_volume_at_price(Price("100.0"), Side::BUY), 20);
+
+  EXPECT_EQ(book.advance_time(now + std::chrono::seconds(5)), 1u);
+  EXPECT_EQ(book.get_volume_at_price(Price("100.0"), Side::BUY), 10);
+  EXPECT_EQ(book.cancel_order(1), OrderResult::ORDER_NOT_FOUND);
+
+  // Already expired on arrival
+  gtt.set_order_id(3);
+  EXPECT_EQ(book.place_order(gtt, trades), OrderResult::CANCELLED);
+}
+
+TEST_F(MatchingTests, ExpiryRunsOnEpochTimeWithoutAClock) {
+  // No advance_time before the first GTT order: the wheel starts at its arrival
+  auto now = std::chrono::system_clock::time_point(std::chrono::milliseconds(1760000000000LL));
+
+  Order gtt("expiring", Price("100.0000"), 1, 10, Side::BUY, now);
+  gtt.set_time_in_force(TimeInForce::GTT);
+  gtt.set_expire_time(now + std::chrono::seconds(90));
+  EXPECT_EQ(book.place_order(gtt, trades), OrderResult::SUCCESS);
+
+  EXPECT_EQ(book.advance_time(now + std::chrono::milliseconds(89999)), 0u);
+  EXPECT_EQ(book.advance_time(now + std::chrono::seconds(90)), 1u);
+  EXPECT_EQ(book.order_count(), 0u);
+}
+
+TEST_F(MatchingTests, FilledAndCancelledOrdersLeaveTheWheel) {
+  auto now = std::chrono::system_clock::now();
+  book.advance_time(now);
+
+  for (int i = 1; i <= 3; ++i) {
+    Order gtt("expiring", Price("100.0000"), i, 10, Side::SELL, now);
+    gtt.set_time_in_force(TimeInForce::GTT);
+    gtt.set_expire_time(now + std::chrono::milliseconds(100));
+    book.place_order(gtt, trades);
+  }
+
+  book.place_order(Order("buyer", Price("100.0000"), 4, 10, Side::BUY, now), trades);
+  book.cancel_order(2);
+  EXPECT_EQ(book.advance_time(now + std::chrono::seconds(1)), 1u);
+  EXPECT_EQ(book.order_count(), 0u);
+}
+
+TEST_F(MatchingTests, DayOrdersExpireAtSessionEnd) {
+  auto now = std::chrono::system_clock::now();
+
+  Order day("day", Price("100.0000"), 1, 10, Side::BUY, now);
+  day.set_time_in_force(TimeInForce::DAY);
+  EXPECT_EQ(book.place_order(day, trades), OrderResult::INVALID_ORDER);
+
+  book.set_session_end(now + std::chrono::hours(8));
+  EXPECT_EQ(book.place_order(day, trades), OrderResult::SUCCESS);
+
+  // A modify keeps the order's time in force
+  book.modify_order(1, Price("99.0000"), 10);
+  EXPECT_EQ(book.advance_time(now + std::chrono::hours(7)), 0u);
+  EXPECT_EQ(book.advance_time(now + std::chrono::hours(8)), 1u);
+  EXPECT_EQ(book.order_count(), 0u);
+}
+
+class SelfTradeTests : public ::testing::Test {
+protected:
+  Orderbook book;
+  std::vector<TradeInfo> trades;
+  std::chrono::system_clock::time_point now = std::chrono::system_clock::now();
+
+  // Two resting sells from participant 7 ahead of one from participant 8
+  void SetUp() override {
+    place(1, 7, 100, 10, Side::SELL);
+    place(2, 7, 100, 10, Side::SELL);
+    place(3, 8, 100, 10, Side::SELL);
+    trades.clear();
+  }
+
+  OrderResult place(int id, int participant, int price, int volume, Side side,
+                    TimeInForce tif = TimeInForce::GTC) {
+    Order order("p" + std::to_string(participant), Price::fromRaw(price * 10000), id, volume, side, now);
+    order.set_participant_id(participant);
+    order.set_time_in_force(tif);
+    return book.place_order(order, trades);
+  }
+};
+
+TEST_F(SelfTradeTests, DisabledByDefault) {
+  EXPECT_EQ(place(4, 7, 100, 15, Side::BUY), OrderResult::COMPLETE_FILL);
+  EXPECT_EQ(trades.size(), 2);
+}
+
+TEST_F(SelfTradeTests, CancelNewest) {
+  book.set_self_trade_prevention(SelfTradePrevention::CANCEL_NEWEST);
+  EXPECT_EQ(place(4, 7, 100, 15, Side::BUY), OrderResult::CANCELLED);
+  EXPECT_TRUE(trades.empty());
+  EXPECT_EQ(book.order_count(), 3);
+}
+
+TEST_F(SelfTradeTests, CancelOldest) {
+  book.set_self_trade_prevention(SelfTradePrevention::CANCEL_OLDEST);
+  EXPECT_EQ(place(4, 7, 100, 15, Side::BUY), OrderResult::PARTIAL_FILL);
+  ASSERT_EQ(trades.size(), 1);
+  EXPECT_EQ(trades[0].counterparty, "p8");
+  EXPECT_EQ(book.get_volume_at_price(Price("100.0"), Side::BUY), 5);
+  EXPECT_EQ(book.get_volume_at_price(Price("100.0"), Side::SELL), 0);
+  EXPECT_EQ(book.order_count(), 1);
+}
+
+TEST_F(SelfTradeTests, CancelBoth) {
+  book.set_self_trade_prevention(SelfTradePrevention::CANCEL_BOTH);
+  EXPECT_EQ(place(4, 7, 100, 15, Side::BUY), OrderResult::CANCELLED);
+  EXPECT_TRUE(trades.empty());
+  EXPECT_EQ(book.get_volume_at_price(Price("100.0"), Side::SELL), 20);
+  EXPECT_EQ(book.cancel_order(1), OrderResult::ORDER_NOT_FOUND);
+}
+
+TEST_F(SelfTradeTests, DecrementAndCancel) {
+  book.set_self_trade_prevention(SelfTradePrevention::DECREMENT_AND_CANCEL);
+
+  // 4 against resting 10: resting shrinks to 6, aggressor is used up
+  EXPECT_EQ(place(4, 7, 100, 4, Side::BUY), OrderResult::CANCELLED);
+  EXPECT_EQ(book.get_volume_at_price(Price("100.0"), Side::SELL), 26);
+
+  // 20: removes the 6 and the 10, then trades 4 with participant 8 - only 4 of
+  // the 20 traded, so this is not a complete fill
+  EXPECT_EQ(place(5, 7, 100, 20, Side::BUY), OrderResult::PARTIAL_FILL);
+  ASSERT_EQ(trades.size(), 1);
+  EXPECT_EQ(trades[0].volume, 4);
+  EXPECT_EQ(book.get_volume_at_price(Price("100.0"), Side::SELL), 6);
+}
+
+TEST_F(SelfTradeTests, FillOrKillWithoutPrevention) {
+  EXPECT_EQ(place(4, 7, 100, 30, Side::BUY, TimeInForce::FOK), OrderResult::COMPLETE_FILL);
+  EXPECT_EQ(trades.size(), 3);
+}
+
+TEST_F(SelfTradeTests, FillOrKillCancelNewest) {
+  book.set_self_trade_prevention(SelfTradePrevention::CANCEL_NEWEST);
+
+  // Own orders stand in front of participant 8's 10 - killed before any trade
+  EXPECT_EQ(place(4, 7, 100, 10, Side::BUY, TimeInForce::FOK), OrderResult::CANCELLED);
+  EXPECT_TRUE(trades.empty());
+  EXPECT_EQ(book.get_volume_at_price(Price("100.0"), Side::SELL), 30);
+
+  // Other participants' liquidity at a better price still fills it
+  place(5, 8, 99, 10, Side::SELL);
+  trades.clear();
+  EXPECT_EQ(place(6, 7, 100, 10, Side::BUY, TimeInForce::FOK), OrderResult::COMPLETE_FILL);
+  ASSERT_EQ(trades.size(), 1);
+  EXPECT_EQ(trades[0].price, Price("99.0"));
+}
+
+TEST_F(SelfTradeTests, FillOrKillCancelOldest) {
+  book.set_self_trade_prevention(SelfTradePrevention::CANCEL_OLDEST);
+
+  // Only participant 8's 10 is tradable
+  EXPECT_EQ(place(4, 7, 100, 15, Side::BUY, TimeInForce::FOK), OrderResult::CANCELLED);
+  EXPECT_TRUE(trades.empty());
+  EXPECT_EQ(book.order_count(), 3);
+
+  EXPECT_EQ(place(5, 7, 100, 10, Side::BUY, TimeInForce::FOK), OrderResult::COMPLETE_FILL);
+  ASSERT_EQ(trades.size(), 1);
+  EXPECT_EQ(trades[0].counterparty, "p8");
+  EXPECT_EQ(book.order_count(), 0);
+}
+
+TEST_F(SelfTradeTests, FillOrKillCancelBoth) {
+  book.set_self_trade_prevention(SelfTradePrevention::CANCEL_BOTH);
+
+  // Killed up front, so the resting own orders survive too
+  EXPECT_EQ(place(4, 7, 100, 5, Side::BUY, TimeInForce::FOK), OrderResult::CANCELLED);
+  EXPECT_TRUE(trades.empty());
+  EXPECT_EQ(book.order_count(), 3);
+}
+
+TEST_F(SelfTradeTests, FillOrKillDecrementAndCancel) {
+  book.set_self_trade_prevention(SelfTradePrevention::DECREMENT_AND_CANCEL);
+
+  // Decrementing would shrink the quantity rather than fill it
+  EXPECT_EQ(place(4, 7, 100, 10, Side::BUY, TimeInForce::FOK), OrderResult::CANCELLED);
+  EXPECT_TRUE(trades.empty());
+  EXPECT_EQ(book.get_volume_at_price(Price("100.0"), Side::SELL), 30);
+
+  // Another participant takes everything
+  EXPECT_EQ(place(5, 9, 100, 30, Side::BUY, TimeInForce::FOK), OrderResult::COMPLETE_FILL);
+  EXPECT_EQ(trades.size(), 3);
+}
+
+TEST_F(SelfTradeTests, AnonymousOrdersNeverSelfMatch) {
+  book.set_self_trade_prevention(SelfTradePrevention::CANCEL_NEWEST);
+  place(4, 0, 101, 5, Side::SELL);
+  EXPECT_EQ(place(5, 0, 101, 35, Side::BUY), OrderResult::COMPLETE_FILL);
+  EXPECT_EQ(trades.size(), 4);
+}
@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <cstring>
+#include "orderbook/Orderbook.h"
+#include "orderbook/ReplayVerifier.h"
+#include "io/Journal.h"
+#include "sim/OrderFlowGenerator.h"
+
+using namespace trading;
+
+class OrderFlowTests : public ::testing::Test {
+protected:
+  // Generates `batches` batches against a book, applying each before the next
+  std::vector<io::EventRecord> drive(Orderbook& book, sim::OrderFlowGenerator& generator, int batches,
+                                     size_t batch_size) {
+    std::vector<io::EventRecord> flow;
+    std::vector<TradeInfo> trades;
+    for (int b = 0; b < batches; ++b) {
+      size_t n = generator.next_batch(book, batch_size);
+      for (size_t i = 0; i < n; ++i) {
+        trades.clear();
+        ReplayVerifier::apply(book, generator[i], trades);
+        flow.push_back(generator[i]);
+      }
+    }
+    return flow;
+  }
+};
+
+TEST_F(OrderFlowTests, SameSeedGivesSameFlowAndBook) {
+  sim::OrderFlowConfig config;
+  config.seed = 11;
+  config.buffer_capacity = 512;
+
+  Orderbook book_a, book_b;
+  sim::OrderFlowGenerator gen_a(config), gen_b(config);
+  auto flow_a = drive(book_a, gen_a, 40, 512);
+  auto flow_b = drive(book_b, gen_b, 40, 512);
+
+  ASSERT_EQ(flow_a.size(), flow_b.size());
+  for (size_t i = 0; i < flow_a.size(); ++i) {
+    ASSERT_EQ(std::memcmp(&flow_a[i], &flow_b[i], sizeof(io::EventRecord)), 0) << "record " << i;
+  }
+  EXPECT_EQ(book_a.checksum(), book_b.checksum());
+  EXPECT_GT(book_a.order_count(), 0u);
+
+  config.seed = 12;
+  Orderbook book_c;
+  sim::OrderFlowGenerator gen_c(config);
+  drive(book_c, gen_c, 40, 512);
+  EXPECT_NE(book_a.checksum(), book_c.checksum());
+}
+
+TEST_F(OrderFlowTests, MixAndPricesFollowConfig) {
+  sim::OrderFlowConfig config;
+  config.add_weight = 0.5;
+  config.cancel_weight = 0.3;
+  config.modify_weight = 0.15;
+  config.aggressive_weight = 0.05;
+  config.initial_mid = Price("100.0000");
+
+  Orderbook book;
+  sim::OrderFlowGenerator generator(config);
+  auto flow = drive(book, generator, 50, 1000);
+
+  size_t places = 0, cancels = 0, modifies = 0, ioc = 0;
+  for (const auto& record : flow) {
+    if (record.type == io::EventType::ORDER_PLACED) {
+      places++;
+      if ((record.flags & io::PLACE_TIME_IN_FORCE_MASK) == static_cast<uint8_t>(TimeInForce::IOC)) {
+        ioc++;
+      }
+      EXPECT_EQ(record.price % 100, 0);
+      EXPECT_NEAR(static_cast<double>(record.price), 1000000.0, 5000.0);
+      EXPECT_EQ(record.client[0], 'P');
+    } else if (record.type == io::EventType::ORDER_CANCELLED) {
+      cancels++;
+    } else if (record.type == io::EventType::ORDER_MODIFIED) {
+      modifies++;
+    }
+  }
+
+  double n = static_cast<double>(flow.size());
+  EXPECT_NEAR(places / n, 0.55, 0.02);
+  EXPECT_NEAR(cancels / n, 0.30, 0.02);
+  EXPECT_NEAR(modifies / n, 0.15, 0.02);
+  EXPECT_NEAR(ioc / n, 0.05, 0.01);
+}
+
+TEST_F(OrderFlowTests, ArrivalRates) {
+  Orderbook book;
+  sim::OrderFlowConfig config;
+  config.base_rate = 50000.0;
+  sim::OrderFlowGenerator poisson(config);
+  drive(book, poisson, 20, 4096);
+  double poisson_seconds = poisson.current_time_ns() * 1e-9;
+  EXPECT_NEAR(poisson.commands_generated() / poisson_seconds, 50000.0, 2500.0);
+
+  // Stationary Hawkes rate is base / (1 - branching ratio)
+  Orderbook hawkes_book;
+  config.arrivals = sim::ArrivalProcess::HAWKES;
+  config.branching_ratio = 0.5;
+  sim::OrderFlowGenerator hawkes(config);
+  drive(hawkes_book, hawkes, 20, 4096);
+  double hawkes_seconds = hawkes.current_time_ns() * 1e-9;
+  EXPECT_NEAR(hawkes.commands_generated() / hawkes_seconds, 100000.0, 15000.0);
+}
+
+TEST_F(OrderFlowTests, RecordedFlowReplaysToSameBook) {
+  std::string path = ::testing::TempDir() + "order_flow.bin";
+  sim::OrderFlowConfig config;
+  config.seed = 3;
+  config.buffer_capacity = 1000;
+
+  Orderbook book;
+  std::vector<io::EventRecord> flow;
+  {
+    sim::OrderFlowGenerator generator(config);
+    generator.record_to(path);
+    flow = drive(book, generator, 10, 1000);
+  }
+
+  auto recorded = io::read_journal(path);
+  std::remove(path.c_str());
+
+  ASSERT_EQ(recorded.size(), flow.size());
+  Orderbook replayed;
+  std::vector<TradeInfo> trades;
+  for (const auto& record : recorded) {
+    ReplayVerifier::apply(replayed, record, trades);
+  }
+  EXPECT_EQ(replayed.checksum(), book.checksum());
+  EXPECT_EQ(replayed.order_count(), book.order_count());
+}
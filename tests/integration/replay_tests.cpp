@@ -0,0 +1,264 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <random>
+#include <stdexcept>
+#include "orderbook/Orderbook.h"
+#include "orderbook/ReplayVerifier.h"
+#include "io/AsyncFileWriter.h"
+#include "io/Journal.h"
+
+using namespace trading;
+
+class ReplayTests : public ::testing::Test {
+protected:
+  std::vector<io::EventRecord> run_primary(int commands, int checkpoint_every) {
+    Orderbook book;
+    return run_primary(book, commands, checkpoint_every);
+  }
+
+  // Drives a primary book with random flow and journals its configuration and
+  // every command
+  template <typename Book>
+  std::vector<io::EventRecord> run_primary(Book& book, int commands, int checkpoint_every) {
+    book.set_output_hash_chain(true);
+    std::vector<TradeInfo> trades;
+    std::vector<io::EventRecord> journal = io::make_config_records(0, ReplayVerifier::config_of(book));
+    std::vector<int> live_ids;
+
+    std::mt19937 gen(7);
+    std::uniform_int_distribution<> price_ticks(9900, 10100);
+    std::uniform_int_distribution<> volume_dist(1, 200);
+    std::uniform_int_distribution<> action_dist(0, 9);
+
+    auto now = std::chrono::system_clock::now();
+    uint64_t seq = 1;
+    int next_id = 1;
+
+    for (int i = 0; i < commands; ++i) {
+      int action = action_dist(gen);
+      trades.clear();
+
+      if (action < 6 || live_ids.empty()) {
+        Side side = (action % 2 == 0) ? Side::BUY : Side::SELL;
+        Order order("client" + std::to_string(i % 5), Price::fromRaw(price_ticks(gen) * 100),
+                    next_id++, volume_dist(gen), side, now);
+        if (i % 17 == 0) {
+          order.set_order_type(OrderType::STOP_LIMIT);
+          order.set_stop_price(Price::fromRaw(price_ticks(gen) * 100));
+        } else if (i % 11 == 0) {
+          order.set_time_in_force(TimeInForce::GTT);
+          order.set_expire_time(now + std::chrono::milliseconds(i + 400));
+        } else if (i % 13 == 0) {
+          order.set_time_in_force(TimeInForce::DAY);
+        }
+        order.set_participant_id(i % 3);
+        journal.push_back(io::make_place_record(seq, order));
+        if (io::needs_extension_record(order)) {
+          journal.push_back(io::make_place_extension_record(seq, order));
+        }
+        seq++;
+        book.place_order(order, trades);
+        live_ids.push_back(order.get_order_id());
+      } else if (action < 8) {
+        int id = live_ids[gen() % live_ids.size()];
+        journal.push_back(io::make_cancel_record(seq++, id));
+        book.cancel_order(id);
+      } else {
+        int id = live_ids[gen() % live_ids.size()];
+        Price price = Price::fromRaw(price_ticks(gen) * 100);
+        int volume = volume_dist(gen);
+        journal.push_back(io::make_modify_record(seq++, id, price, volume));
+        book.modify_order(id, price, volume);
+      }
+
+      if ((i + 1) % checkpoint_every == 0) {
+        auto clock = now + std::chrono::milliseconds(i);
+        journal.push_back(io::make_time_record(seq++, clock));
+        book.advance_time(clock);
+        journal.push_back(io::make_checkpoint_record(seq++, book.checksum(), book.output_hash()));
+      }
+    }
+
+    return journal;
+  }
+};
+
+TEST_F(ReplayTests, ReplayMatchesPrimaryAtEveryCheckpoint) {
+  auto journal = run_primary(5000, 250);
+
+  ReplayVerifier verifier;
+  ReplayReport report = verifier.verify(journal);
+
+  EXPECT_TRUE(report.consistent);
+  EXPECT_EQ(report.records_applied, 5020u);
+  EXPECT_EQ(report.checkpoints_verified, 20u);
+}
+
+TEST_F(ReplayTests, ReplaysIntoTheJournaledConfiguration) {
+  FifoLmmOrderbook book(TickTable({{Price(), Price("0.01")}, {Price("100"), Price("0.05")}}));
+  book.matching_policy().lmm_participant_id = 1;
+  book.matching_policy().lmm_percent = 40;
+  book.set_self_trade_prevention(SelfTradePrevention::CANCEL_OLDEST);
+  book.set_session_end(std::chrono::system_clock::now() + std::chrono::seconds(3));
+  auto journal = run_primary(book, 5000, 250);
+
+  ReplayVerifier verifier;
+  ReplayReport report = verifier.verify(journal);
+  EXPECT_TRUE(report.consistent);
+  EXPECT_EQ(report.checkpoints_verified, 20u);
+
+  // The same commands replayed into a default book diverge
+  io::BookConfig config;
+  size_t header = io::read_config(journal, config);
+  ASSERT_EQ(header, 3u);
+  EXPECT_EQ(config.policy, io::BookPolicy::FIFO_LMM);
+  EXPECT_EQ(config.stp_mode, SelfTradePrevention::CANCEL_OLDEST);
+  journal.erase(journal.begin(), journal.begin() + static_cast<std::ptrdiff_t>(header));
+  EXPECT_FALSE(verifier.verify(journal).consistent);
+}
+
+TEST_F(ReplayTests, RejectsMalformedHeaders) {
+  io::BookConfig config;
+  config.policy = io::BookPolicy::PRO_RATA;
+  auto journal = io::make_config_records(0, config);
+  ASSERT_EQ(journal.size(), 2u);
+
+  ReplayVerifier verifier;
+  EXPECT_TRUE(verifier.verify(journal).consistent);
+
+  journal.pop_back();
+  EXPECT_THROW(verifier.verify(journal), std::runtime_error);
+
+  journal = io::make_config_records(0, config);
+  journal.front().order_type = 9;
+  EXPECT_THROW(verifier.verify(journal), std::runtime_error);
+
+  // A header in the middle of a journal is not applied silently
+  journal = io::make_config_records(0, config);
+  journal.push_back(io::make_cancel_record(1, 1));
+  journal.push_back(journal.front());
+  EXPECT_THROW(verifier.verify(journal), std::runtime_error);
+}
+
+TEST_F(ReplayTests, ReplaysMassCancels) {
+  Orderbook book;
+  auto journal = run_primary(book, 2000, 500);
+  uint64_t seq = journal.back().sequence + 1;
+  size_t commands = journal.size();
+
+  MassCancelFilter filter;
+  filter.include_sells = false;
+  filter.max_price = Price("100.50");
+  journal.push_back(io::make_mass_cancel_record(seq++, 1, filter));
+  EXPECT_GT(book.mass_cancel(1, filter), 0u);
+  journal.push_back(io::make_mass_cancel_record(seq++, 2, MassCancelFilter()));
+  EXPECT_GT(book.mass_cancel(2), 0u);
+  journal.push_back(io::make_checkpoint_record(seq++, book.checksum(), book.output_hash()));
+
+  MassCancelFilter decoded = io::mass_cancel_filter_from_record(journal[commands]);
+  EXPECT_TRUE(decoded.include_buys);
+  EXPECT_FALSE(decoded.include_sells);
+  EXPECT_EQ(decoded.min_price, Price());
+  EXPECT_EQ(decoded.max_price, Price("100.50"));
+
+  ReplayVerifier verifier;
+  ReplayReport report = verifier.verify(journal);
+  EXPECT_TRUE(report.consistent);
+  EXPECT_EQ(report.checkpoints_verified, 5u);
+
+  // The final checkpoint only holds with both mass cancels applied
+  journal.erase(journal.begin() + static_cast<std::ptrdiff_t>(commands));
+  EXPECT_FALSE(verifier.verify(journal).consistent);
+}
+
+TEST_F(ReplayTests, ReplaysAuctionPhases) {
+  Orderbook book;
+  auto journal = run_primary(book, 2000, 500);
+  uint64_t seq = journal.back().sequence + 1;
+  size_t auction_start = journal.size();
+  std::vector<TradeInfo> trades;
+  auto now = std::chrono::system_clock::now();
+
+  journal.push_back(io::make_auction_record(seq++));
+  book.begin_auction();
+
+  // Crossing orders rest during the auction and trade at the uncross
+  for (int i = 0; i < 20; ++i) {
+    Order order("auction", Price::fromRaw((9950 + i * 5) * 100), 100000 + i, 50,
+                i % 2 == 0 ? Side::BUY : Side::SELL, now);
+    journal.push_back(io::make_place_record(seq++, order));
+    book.place_order(order, trades);
+  }
+  journal.push_back(io::make_checkpoint_record(seq++, book.checksum(), book.output_hash()));
+
+  AuctionResult result = book.uncross(trades, Price("100.00"));
+  EXPECT_GT(result.volume, 0);
+  journal.push_back(io::make_uncross_record(seq++, Price("100.00")));
+  journal.push_back(io::make_checkpoint_record(seq++, book.checksum(), book.output_hash()));
+
+  ReplayVerifier verifier;
+  ReplayReport report = verifier.verify(journal);
+  EXPECT_TRUE(report.consistent);
+  EXPECT_EQ(report.checkpoints_verified, 6u);
+
+  // Without the phase change the auction orders match on arrival instead
+  journal.erase(journal.begin() + static_cast<std::ptrdiff_t>(auction_start));
+  EXPECT_FALSE(verifier.verify(journal).consistent);
+}
+
+TEST_F(ReplayTests, ProfiledReplayAttributesEveryCommand) {
+  auto journal = run_primary(2000, 500);
+
+  size_t places = 0, cancels = 0, modifies = 0;
+  for (const auto& record : journal) {
+    places += record.type == io::EventType::ORDER_PLACED;
+    cancels += record.type == io::EventType::ORDER_CANCELLED;
+    modifies += record.type == io::EventType::ORDER_MODIFIED;
+  }
+
+  BookProfiler profiler;
+  ReplayVerifier verifier;
+  ReplayReport report = verifier.verify(journal, &profiler);
+
+  EXPECT_TRUE(report.consistent);
+  EXPECT_EQ(profiler.totals(BookOperation::PLACE).calls, places);
+  EXPECT_EQ(profiler.totals(BookOperation::CANCEL).calls, cancels);
+  EXPECT_EQ(profiler.totals(BookOperation::MODIFY).calls, modifies);
+}
+
+TEST_F(ReplayTests, DetectsDivergence) {
+  auto journal = run_primary(2000, 100);
+
+  // Alter the size of one order in the middle of the run
+  size_t i = 700;
+  while (journal[i].type != io::EventType::ORDER_PLACED) i++;
+  journal[i].volume += 1;
+
+  ReplayVerifier verifier;
+  ReplayReport report = verifier.verify(journal);
+
+  EXPECT_FALSE(report.consistent);
+  EXPECT_NE(report.expected_checksum ^ report.expected_output_hash,
+            report.actual_checksum ^ report.actual_output_hash);
+  EXPECT_LT(report.checkpoints_verified, 20u);
+}
+
+TEST_F(ReplayTests, ReplaysJournalWrittenByAsyncWriter) {
+  auto journal = run_primary(3000, 500);
+  std::string path = ::testing::TempDir() + "replay_journal.bin";
+
+  {
+    io::AsyncFileWriter writer(path);
+    for (const auto& record : journal) {
+      writer.write(record);
+    }
+  }
+
+  ReplayVerifier verifier;
+  ReplayReport report = verifier.verify_file(path);
+  std::remove(path.c_str());
+
+  EXPECT_TRUE(report.consistent);
+  EXPECT_EQ(report.records_applied, 3006u);
+  EXPECT_EQ(report.checkpoints_verified, 6u);
+}
@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <vector>
+#include "io/AsyncFileWriter.h"
+
+using namespace trading;
+using namespace trading::io;
+
+class AsyncFileWriterTests : public ::testing::TestWithParam<WriterBackend> {
+protected:
+  std::string path;
+
+  void SetUp() override {
+    // One file per test and backend, so tests can run in parallel under ctest -j
+    std::string name = ::testing::UnitTest::GetInstance()->current_test_info()->name();
+    std::replace(name.begin(), name.end(), '/', '_');
+    path = ::testing::TempDir() + "async_writer_" + name + "_" +
+           std::to_string(static_cast<int>(GetParam())) + ".bin";
+  }
+
+  void TearDown() override {
+    std::remove(path.c_str());
+  }
+
+  std::vector<EventRecord> read_back() {
+    std::ifstream in(path, std::ios::binary);
+    std::vector<EventRecord> records;
+    EventRecord record;
+    while (in.read(reinterpret_cast<char*>(&record), sizeof(record))) {
+      records.push_back(record);
+    }
+    return records;
+  }
+};
+
+TEST_P(AsyncFileWriterTests, WritesAllRecordsInOrder) {
+  AsyncWriterConfig config;
+  config.backend = GetParam();
+  config.ring_capacity = 1024;
+  config.buffer_count = 4;
+  config.buffer_size = 64 * sizeof(EventRecord);
+
+  const int count = 20000;
+  {
+    AsyncFileWriter writer(path, config);
+    for (int i = 0; i < count; ++i) {
+      EventRecord record{};
+      record.sequence = i;
+      record.type = EventType::TRADE;
+      record.order_id = i;
+      record.volume = i % 500;
+      writer.write(record);
+    }
+    writer.close();
+
+    auto stats = writer.stats();
+    EXPECT_EQ(stats.records_written, static_cast<uint64_t>(count));
+    EXPECT_EQ(stats.bytes_written, count * sizeof(EventRecord));
+    EXPECT_EQ(stats.io_errors, 0u);
+    EXPECT_GT(stats.submissions, 0u);
+    EXPECT_GT(stats.megabytes_per_second, 0.0);
+    EXPECT_LE(stats.producer_p50_ns, stats.producer_p99_ns);
+    EXPECT_LE(stats.producer_p99_ns, stats.producer_max_ns);
+  }
+
+  auto records = read_back();
+  ASSERT_EQ(records.size(), static_cast<size_t>(count));
+  for (int i = 0; i < count; ++i) {
+    EXPECT_EQ(records[i].sequence, static_cast<uint64_t>(i));
+    EXPECT_EQ(records[i].order_id, i);
+    EXPECT_EQ(records[i].type, EventType::TRADE);
+  }
+}
+
+TEST_P(AsyncFileWriterTests, TryWriteReportsDropsWhenRingIsFull) {
+  AsyncWriterConfig config;
+  config.backend = GetParam();
+  config.ring_capacity = 2;
+
+  AsyncFileWriter writer(path, config);
+  EventRecord record{};
+  int accepted = 0;
+  for (int i = 0; i < 10000; ++i) {
+    record.sequence = i;
+    if (writer.try_write(record)) accepted++;
+  }
+  writer.close();
+
+  auto stats = writer.stats();
+  EXPECT_EQ(stats.records_written, static_cast<uint64_t>(accepted));
+  EXPECT_EQ(stats.records_dropped, static_cast<uint64_t>(10000 - accepted));
+}
+
+INSTANTIATE_TEST_SUITE_P(Backends, AsyncFileWriterTests,
+                         ::testing::Values(WriterBackend::AUTO, WriterBackend::PWRITEV));
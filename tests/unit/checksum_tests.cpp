@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+#include "orderbook/Orderbook.h"
+
+using namespace trading;
+
+class ChecksumTests : public ::testing::Test {
+protected:
+  Orderbook book;
+  std::vector<TradeInfo> trades;
+  std::chrono::system_clock::time_point now = std::chrono::system_clock::now();
+};
+
+TEST_F(ChecksumTests, EmptyBookAfterCancelReturnsToZero) {
+  EXPECT_EQ(book.checksum(), 0u);
+
+  book.place_order(Order("c1", Price("100.0000"), 1, 50, Side::BUY, now), trades);
+  book.place_order(Order("c2", Price("101.0000"), 2, 30, Side::SELL, now), trades);
+  EXPECT_NE(book.checksum(), 0u);
+
+  book.cancel_order(1);
+  book.cancel_order(2);
+  EXPECT_EQ(book.checksum(), 0u);
+}
+
+TEST_F(ChecksumTests, MatchesBookBuiltDirectlyInFinalState) {
+  book.place_order(Order("seller", Price("100.0000"), 1, 50, Side::SELL, now), trades);
+  book.place_order(Order("buyer", Price("100.0000"), 2, 30, Side::BUY, now), trades);
+
+  Orderbook direct;
+  direct.place_order(Order("seller", Price("100.0000"), 1, 20, Side::SELL, now), trades);
+
+  EXPECT_EQ(book.checksum(), direct.checksum());
+}
+
+TEST_F(ChecksumTests, QueueOrderIsPartOfState) {
+  book.place_order(Order("c1", Price("100.0000"), 1, 50, Side::BUY, now), trades);
+  book.place_order(Order("c2", Price("100.0000"), 2, 50, Side::BUY, now), trades);
+
+  Orderbook reversed;
+  reversed.place_order(Order("c2", Price("100.0000"), 2, 50, Side::BUY, now), trades);
+  reversed.place_order(Order("c1", Price("100.0000"), 1, 50, Side::BUY, now), trades);
+
+  EXPECT_NE(book.checksum(), reversed.checksum());
+}
+
+TEST_F(ChecksumTests, CancelFromMiddleOfQueue) {
+  book.place_order(Order("c1", Price("100.0000"), 1, 10, Side::SELL, now), trades);
+  book.place_order(Order("c2", Price("100.0000"), 2, 20, Side::SELL, now), trades);
+  book.place_order(Order("c3", Price("100.0000"), 3, 30, Side::SELL, now), trades);
+  book.cancel_order(2);
+
+  Orderbook direct;
+  direct.place_order(Order("c1", Price("100.0000"), 1, 10, Side::SELL, now), trades);
+  direct.place_order(Order("c3", Price("100.0000"), 3, 30, Side::SELL, now), trades);
+
+  EXPECT_EQ(book.checksum(), direct.checksum());
+}
+
+TEST_F(ChecksumTests, VolumeReductionUpdatesChecksum) {
+  book.place_order(Order("c1", Price("100.0000"), 1, 100, Side::BUY, now), trades);
+  uint64_t before = book.checksum();
+
+  book.modify_order(1, Price("100.0000"), 40);
+  EXPECT_NE(book.checksum(), before);
+
+  Orderbook direct;
+  direct.place_order(Order("c1", Price("100.0000"), 1, 40, Side::BUY, now), trades);
+  EXPECT_EQ(book.checksum(), direct.checksum());
+}
+
+TEST_F(ChecksumTests, OutputHashChainIsOptIn) {
+  book.place_order(Order("s", Price("100.0000"), 1, 50, Side::SELL, now), trades);
+  book.place_order(Order("b", Price("100.0000"), 2, 10, Side::BUY, now), trades);
+  EXPECT_EQ(book.output_hash(), 0u);
+
+  book.set_output_hash_chain(true);
+  book.place_order(Order("b", Price("100.0000"), 3, 10, Side::BUY, now), trades);
+  uint64_t first = book.output_hash();
+  EXPECT_NE(first, 0u);
+
+  book.place_order(Order("b", Price("100.0000"), 4, 10, Side::BUY, now), trades);
+  EXPECT_NE(book.output_hash(), first);
+}
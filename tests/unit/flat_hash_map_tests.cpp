@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <unordered_map>
+#include "common/FlatHashMap.h"
+#include "common/FixedPoint.h"
+
+using namespace trading;
+
+TEST(FlatHashMapTests, InsertFindErase) {
+  FlatHashMap<int, int> map;
+  EXPECT_EQ(map.find(1), map.end());
+
+  map[1] = 10;
+  map[2] = 20;
+  EXPECT_EQ(map.size(), 2u);
+  ASSERT_NE(map.find(1), map.end());
+  EXPECT_EQ(map.find(1)->second, 10);
+
+  map.erase(map.find(1));
+  EXPECT_EQ(map.find(1), map.end());
+  EXPECT_EQ(map.erase(2), 1u);
+  EXPECT_EQ(map.erase(2), 0u);
+  EXPECT_TRUE(map.empty());
+}
+
+TEST(FlatHashMapTests, MatchesUnorderedMapUnderChurn) {
+  FlatHashMap<Price, int> map;
+  std::unordered_map<Price, int> reference;
+  std::mt19937 gen(5);
+  std::uniform_int_distribution<> key_dist(0, 3000);
+
+  for (int i = 0; i < 200000; ++i) {
+    Price key = Price::fromRaw(key_dist(gen) * 100);
+    if (gen() % 3 == 0) {
+      ASSERT_EQ(map.erase(key), reference.erase(key));
+    } else {
+      map[key] = i;
+      reference[key] = i;
+    }
+    if (i % 1000 == 0) {
+      ASSERT_EQ(map.size(), reference.size());
+      for (int k = 0; k <= 3000; k += 7) {
+        Price probe = Price::fromRaw(k * 100);
+        auto it = reference.find(probe);
+        auto found = map.find(probe);
+        ASSERT_EQ(found == map.end(), it == reference.end()) << k;
+        if (found != map.end()) ASSERT_EQ(found->second, it->second);
+      }
+    }
+  }
+}
+
+TEST(FlatHashMapTests, GrowsOnceAndShrinksOnRehash) {
+  FlatHashMap<int, int> map;
+  map.reserve(1000);
+  size_t capacity = map.capacity();
+  for (int i = 0; i < 1000; ++i) map[i] = i;
+  EXPECT_EQ(map.capacity(), capacity);
+
+  for (int i = 0; i < 990; ++i) map.erase(i);
+  map.rehash(0);
+  EXPECT_EQ(map.capacity(), 32u);
+  for (int i = 990; i < 1000; ++i) EXPECT_EQ(map.find(i)->second, i);
+
+  FlatHashMap<int, int> moved(std::move(map));
+  EXPECT_EQ(moved.size(), 10u);
+  EXPECT_TRUE(map.empty());
+  map[5] = 5;
+  EXPECT_EQ(map.find(5)->second, 5);
+}
+
+TEST(FlatHashMapTests, EmptyAndMovedFromMapsOwnNoTable) {
+  FlatHashMap<int, int> map;
+  EXPECT_EQ(map.capacity(), 0u);
+  EXPECT_EQ(map.erase(3), 0u);
+
+  map[3] = 30;
+  FlatHashMap<int, int> moved(std::move(map));
+  EXPECT_EQ(moved.find(3)->second, 30);
+  EXPECT_EQ(map.capacity(), 0u);
+  EXPECT_EQ(map.find(3), map.end());
+
+  // Still usable after the move
+  map[4] = 40;
+  EXPECT_EQ(map.size(), 1u);
+  map.erase(4);
+  map.rehash(0);
+  EXPECT_EQ(map.capacity(), 0u);
+}
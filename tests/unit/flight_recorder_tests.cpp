@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include <csignal>
+#include <cstdio>
+#include <sstream>
+#include <thread>
+#include "utils/FlightRecorder.h"
+#include "orderbook/Orderbook.h"
+
+using namespace trading;
+using trace::FlightRecorder;
+using trace::TraceEvent;
+
+class FlightRecorderTests : public ::testing::Test {
+protected:
+  void SetUp() override {
+    FlightRecorder::local().clear();
+    // One file per test, so tests can run in parallel under ctest -j
+    path = ::testing::TempDir() + "flight_recorder_" +
+           ::testing::UnitTest::GetInstance()->current_test_info()->name() + ".trace";
+  }
+  void TearDown() override { std::remove(path.c_str()); }
+
+  std::string path;
+};
+
+TEST_F(FlightRecorderTests, RingKeepsMostRecentRecordsInOrder) {
+  FlightRecorder& recorder = FlightRecorder::local();
+  size_t total = FlightRecorder::CAPACITY + 100;
+  for (size_t i = 0; i < total; ++i) {
+    recorder.record(TraceEvent::PLACE, static_cast<int>(i), 1000000, 10, 0, 0);
+  }
+
+  auto records = recorder.snapshot();
+  ASSERT_EQ(records.size(), FlightRecorder::CAPACITY);
+  EXPECT_EQ(records.front().order_id, 100);
+  EXPECT_EQ(records.back().order_id, static_cast<int>(total - 1));
+  for (size_t i = 1; i < records.size(); ++i) {
+    ASSERT_LE(records[i - 1].tsc, records[i].tsc);
+  }
+}
+
+TEST_F(FlightRecorderTests, DumpDecodesIntoOneTimeline) {
+  FlightRecorder::local().record(TraceEvent::PLACE, 1, 1000000, 50, 0, 0);
+  std::thread other([] {
+    FlightRecorder::local().record(TraceEvent::CANCEL, 2, 0, 0, 0, 0);
+  });
+  other.join();
+  // The other thread's ring is gone with the thread; record a later event here
+  FlightRecorder::local().record(TraceEvent::TRADE, 1, 1000000, 20, 7, 0);
+  FlightRecorder::dump_all(path);
+
+  trace::DecodedTrace decoded = trace::decode_trace(path);
+  ASSERT_EQ(decoded.records.size(), 2u);
+  EXPECT_EQ(decoded.records[0].record.event, TraceEvent::PLACE);
+  EXPECT_EQ(decoded.records[1].record.event, TraceEvent::TRADE);
+  EXPECT_EQ(decoded.records[1].record.aux, 7);
+  EXPECT_GT(decoded.ticks_per_ns, 0.0);
+
+  std::ostringstream out;
+  trace::print_timeline(decoded, out);
+  EXPECT_NE(out.str().find("PLACE"), std::string::npos);
+  EXPECT_NE(out.str().find("#1 BUY 20 @ 100.0000 vs #7"), std::string::npos);
+}
+
+TEST_F(FlightRecorderTests, RejectsFilesThatAreNotDumps) {
+  {
+    std::FILE* f = std::fopen(path.c_str(), "wb");
+    std::fputs("not a trace dump, just some text padding", f);
+    std::fclose(f);
+  }
+  EXPECT_THROW(trace::decode_trace(path), std::runtime_error);
+  EXPECT_THROW(trace::decode_trace(path + ".missing"), std::system_error);
+}
+
+TEST_F(FlightRecorderTests, CrashHandlerDumpsBeforeDying) {
+  EXPECT_EXIT(
+      {
+        FlightRecorder::install_crash_handler(path);
+        FlightRecorder::local().record(TraceEvent::CANCEL, 42, 0, 0, 0, 0);
+        std::raise(SIGSEGV);
+      },
+      ::testing::KilledBySignal(SIGSEGV), "");
+
+  trace::DecodedTrace decoded = trace::decode_trace(path);
+  ASSERT_FALSE(decoded.records.empty());
+  EXPECT_EQ(decoded.records.back().record.event, TraceEvent::CANCEL);
+  EXPECT_EQ(decoded.records.back().record.order_id, 42);
+}
+
+TEST_F(FlightRecorderTests, BookEventsAreTraced) {
+#if ORDERBOOK_FLIGHT_RECORDER
+  Orderbook book;
+  std::vector<TradeInfo> trades;
+  auto now = std::chrono::system_clock::now();
+  FlightRecorder::local().clear();
+
+  book.place_order(Order("s", Price("100.0000"), 1, 10, Side::SELL, now), trades);
+  book.place_order(Order("b", Price("100.0000"), 2, 10, Side::BUY, now), trades);
+  book.cancel_order(3);
+
+  std::vector<TraceEvent> events;
+  for (const auto& r : FlightRecorder::local().snapshot()) events.push_back(r.event);
+  std::vector<TraceEvent> expected = {TraceEvent::PLACE, TraceEvent::LEVEL_CREATE, TraceEvent::PLACE,
+                                      TraceEvent::TRADE, TraceEvent::LEVEL_REMOVE, TraceEvent::CANCEL};
+  EXPECT_EQ(events, expected);
+#else
+  GTEST_SKIP() << "built without ORDERBOOK_FLIGHT_RECORDER";
+#endif
+}
@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+#include <random>
+#include "utils/LatencyHistogram.h"
+#include "orderbook/Orderbook.h"
+
+using namespace trading;
+using metrics::LatencyHistogram;
+
+TEST(LatencyHistogramTests, BucketsAreContiguousAndBoundValues) {
+  std::mt19937_64 gen(7);
+  for (int i = 0; i < 100000; ++i) {
+    uint64_t value = gen() >> (gen() % 64);
+    size_t index = LatencyHistogram::bucket_index(value);
+    ASSERT_LT(index, LatencyHistogram::BUCKET_COUNT);
+    EXPECT_LE(value, LatencyHistogram::bucket_upper(index));
+    if (index > 0) {
+      EXPECT_GT(value, LatencyHistogram::bucket_upper(index - 1));
+    }
+    // Relative error bounded by the sub-bucket resolution
+    uint64_t width = LatencyHistogram::bucket_upper(index) - value;
+    EXPECT_LE(width, value / LatencyHistogram::SUB_BUCKETS);
+  }
+  EXPECT_EQ(LatencyHistogram::bucket_upper(LatencyHistogram::BUCKET_COUNT - 1), UINT64_MAX);
+}
+
+TEST(LatencyHistogramTests, PercentilesWithinResolution) {
+  LatencyHistogram histogram;
+  for (uint64_t v = 1; v <= 10000; ++v) {
+    histogram.record(v);
+  }
+
+  EXPECT_EQ(histogram.count(), 10000u);
+  EXPECT_EQ(histogram.min(), 1u);
+  EXPECT_EQ(histogram.max(), 10000u);
+
+  auto near = [](uint64_t actual, uint64_t expected) {
+    return actual >= expected && actual <= expected + expected / LatencyHistogram::SUB_BUCKETS;
+  };
+  EXPECT_TRUE(near(histogram.value_at_percentile(50.0), 5000));
+  EXPECT_TRUE(near(histogram.value_at_percentile(99.0), 9900));
+  EXPECT_TRUE(near(histogram.value_at_percentile(99.9), 9990));
+  EXPECT_EQ(histogram.value_at_percentile(100.0), 10000u);
+
+  histogram.reset();
+  EXPECT_EQ(histogram.count(), 0u);
+  EXPECT_EQ(histogram.value_at_percentile(50.0), 0u);
+}
+
+TEST(LatencyHistogramTests, BookRecordsOnlyWhenEnabled) {
+  Orderbook book;
+  std::vector<TradeInfo> trades;
+  auto now = std::chrono::system_clock::now();
+  for (int i = 1; i <= 100; ++i) {
+    book.place_order(Order("c", Price("100.0000"), i, 10, Side::BUY, now), trades);
+  }
+  book.cancel_order(1);
+
+  uint64_t expected_places = ORDERBOOK_LATENCY_STATS ? 100 : 0;
+  EXPECT_EQ(book.latency_summary(BookOperation::PLACE).count, expected_places);
+  EXPECT_EQ(book.latency_summary(BookOperation::CANCEL).count, ORDERBOOK_LATENCY_STATS ? 1u : 0u);
+  EXPECT_LE(book.latency_summary(BookOperation::PLACE).p50, book.latency_summary(BookOperation::PLACE).max);
+
+  book.reset_latency_stats();
+  EXPECT_EQ(book.latency_summary(BookOperation::PLACE).count, 0u);
+}
@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "common/MemoryPool.h"
+
+using namespace trading;
+
+namespace {
+
+struct Item {
+  int value = 0;
+};
+
+using SmallPool = memory::MemoryPool<Item, 8>;
+
+}
+
+TEST(MemoryPoolTests, StatsTrackUsageAndOccupancy) {
+  SmallPool pool;
+  std::vector<Item*> items;
+  for (int i = 0; i < 20; ++i) {
+    items.push_back(pool.allocate());
+  }
+
+  auto stats = pool.stats();
+  EXPECT_EQ(stats.blocks, 3u);
+  EXPECT_EQ(stats.capacity, 24u);
+  EXPECT_EQ(stats.used, 20u);
+  EXPECT_EQ(stats.high_water, 20u);
+  EXPECT_EQ(stats.allocations, 20u);
+  EXPECT_EQ(stats.blocks_allocated, 3u);
+  EXPECT_EQ(stats.bytes(), 3 * stats.block_bytes);
+  // Two full blocks and one at 4/8
+  EXPECT_EQ(stats.occupancy[memory::OCCUPANCY_BUCKETS - 1], 2u);
+  EXPECT_EQ(stats.occupancy[3], 1u);
+  EXPECT_EQ(stats.empty_blocks, 0u);
+
+  for (int i = 0; i < 10; ++i) {
+    pool.deallocate(items[i]);
+  }
+  stats = pool.stats();
+  EXPECT_EQ(stats.used, 10u);
+  EXPECT_EQ(stats.high_water, 20u);
+  EXPECT_EQ(stats.deallocations, 10u);
+  EXPECT_EQ(stats.empty_blocks, 1u);
+  // 10 live objects pin two blocks with 16 slots
+  EXPECT_DOUBLE_EQ(stats.fragmentation(), 1.0 - 10.0 / 16.0);
+
+  auto later = stats;
+  later.allocations += 500;
+  EXPECT_DOUBLE_EQ(later.allocation_rate(stats, 2.0), 250.0);
+}
+
+TEST(MemoryPoolTests, TrimReleasesEmptyBlocksOnly) {
+  SmallPool pool;
+  std::vector<Item*> items;
+  for (int i = 0; i < 32; ++i) {
+    items.push_back(pool.allocate());
+    items.back()->value = i;
+  }
+  ASSERT_EQ(pool.block_count(), 4u);
+
+  // Empty the first and third blocks, leave one object in the second
+  for (int i = 0; i < 8; ++i) pool.deallocate(items[i]);
+  for (int i = 9; i < 24; ++i) pool.deallocate(items[i]);
+
+  EXPECT_EQ(pool.trim(1), 1u);
+  EXPECT_EQ(pool.block_count(), 3u);
+  EXPECT_EQ(pool.trim(), 1u);
+  EXPECT_EQ(pool.block_count(), 2u);
+  EXPECT_EQ(pool.stats().blocks_released, 2u);
+
+  // Survivors are untouched and still owned
+  EXPECT_EQ(items[8]->value, 8);
+  for (int i = 24; i < 32; ++i) EXPECT_EQ(items[i]->value, i);
+  EXPECT_EQ(pool.total_used(), 9u);
+
+  pool.deallocate(items[8]);
+  for (int i = 24; i < 32; ++i) pool.deallocate(items[i]);
+  EXPECT_EQ(pool.trim(), 1u);
+  EXPECT_EQ(pool.block_count(), 1u);
+  EXPECT_NE(pool.allocate(), nullptr);
+}
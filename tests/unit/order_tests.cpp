@@ -26,6 +26,11 @@ TEST(OrderTests, Setters) {
   
   order.set_client("newclient");
   EXPECT_EQ(order.get_client(), "newclient");
+
+  // Client names are stored inline and truncated to ClientName's capacity
+  order.set_client(std::string("a-client-name-longer-than-capacity"));
+  EXPECT_EQ(order.get_client().size(), ClientName::capacity());
+  EXPECT_EQ(order.get_client(), std::string("a-client-name-longer-than-capacity").substr(0, ClientName::capacity()));
   
   order.set_price(Price("42.0000"));
   EXPECT_EQ(order.get_price().to_double(), 42.0);
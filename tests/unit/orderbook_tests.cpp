@@ -1,4 +1,8 @@
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <set>
+#include <thread>
 #include "orderbook/Orderbook.h"
 
 using namespace trading;
@@ -124,6 +128,102 @@ TEST_F(OrderbookTests, ModifyOrderPrice) {
   EXPECT_EQ(book.price_level_count(), 1);
 }
 
+TEST_F(OrderbookTests, ModifyOrderCrossingReportsFills) {
+  auto now = std::chrono::system_clock::now();
+
+  Order ask("seller", Price("101.0000"), 1, 60, Side::SELL, now);
+  Order bid("buyer", Price("100.0000"), 2, 100, Side::BUY, now);
+  book.place_order(ask, trades);
+  book.place_order(bid, trades);
+  trades.clear();
+
+  // Amending the bid through the ask matches it and rests the remainder
+  auto result = book.modify_order(2, Price("101.0000"), 100, trades);
+  EXPECT_EQ(result, OrderResult::PARTIAL_FILL);
+  ASSERT_EQ(trades.size(), 1);
+  EXPECT_EQ(trades[0].order_id, 2);
+  EXPECT_EQ(trades[0].counterparty, "seller");
+  EXPECT_EQ(trades[0].volume, 60);
+  EXPECT_EQ(book.get_volume_at_price(Price("101.0"), Side::BUY), 40);
+  EXPECT_EQ(book.order_count(), 1);
+
+  // Amending the rest into nothing fills completely and removes it
+  Order ask2("seller", Price("102.0000"), 3, 40, Side::SELL, now);
+  book.place_order(ask2, trades);
+  trades.clear();
+  EXPECT_EQ(book.modify_order(2, Price("102.0000"), 40, trades), OrderResult::COMPLETE_FILL);
+  EXPECT_EQ(trades.size(), 1);
+  EXPECT_EQ(book.order_count(), 0);
+  EXPECT_EQ(book.price_level_count(), 0);
+}
+
+TEST_F(OrderbookTests, ModifyOrderSweepKeepsLookupConsistent) {
+  // Fills during the amend erase map entries, which shifts others in the table;
+  // scattered ids make those shifts cross the amended order's slot
+  auto now = std::chrono::system_clock::now();
+  std::mt19937 gen(46);
+  std::uniform_int_distribution<int> id_dist(1, 1 << 30);
+
+  for (int trial = 0; trial < 200; ++trial) {
+    Orderbook fresh;
+    std::set<int> ids;
+    while (ids.size() < 24) {
+      ids.insert(id_dist(gen));
+    }
+    std::vector<int> all(ids.begin(), ids.end());
+    std::shuffle(all.begin(), all.end(), gen);
+
+    int amended = all[0];
+    for (size_t i = 1; i < 9; ++i) {
+      fresh.place_order(Order("seller", Price::fromRaw((101 + i % 3) * 10000), all[i], 10, Side::SELL, now), trades);
+    }
+    for (size_t i = 9; i < all.size(); ++i) {
+      fresh.place_order(Order("filler", Price::fromRaw((90 - i % 5) * 10000), all[i], 10, Side::BUY, now), trades);
+    }
+    fresh.place_order(Order("buyer", Price("95.0000"), amended, 80, Side::BUY, now), trades);
+
+    ASSERT_EQ(fresh.modify_order(amended, Price("103.0000"), 80, trades), OrderResult::COMPLETE_FILL);
+    ASSERT_FALSE(fresh.has_order(amended)) << "trial " << trial;
+    for (size_t i = 1; i < 9; ++i) {
+      ASSERT_FALSE(fresh.has_order(all[i]));
+    }
+    for (size_t i = 9; i < all.size(); ++i) {
+      ASSERT_EQ(fresh.cancel_order(all[i]), OrderResult::SUCCESS);
+    }
+    EXPECT_EQ(fresh.order_count(), 0);
+  }
+}
+
+TEST_F(OrderbookTests, ModifyOrderIncreaseLosesPriority) {
+  auto now = std::chrono::system_clock::now();
+
+  Order first("client1", Price("100.0000"), 1, 50, Side::BUY, now);
+  Order second("client2", Price("100.0000"), 2, 50, Side::BUY, now);
+  book.place_order(first, trades);
+  book.place_order(second, trades);
+
+  // Same price, more volume: order 1 goes behind order 2
+  EXPECT_EQ(book.modify_order(1, Price("100.0000"), 80), OrderResult::SUCCESS);
+  EXPECT_EQ(book.get_volume_at_price(Price("100.0"), Side::BUY), 130);
+
+  Order sell("client3", Price("100.0000"), 3, 50, Side::SELL, now);
+  book.place_order(sell, trades);
+  ASSERT_EQ(trades.size(), 1);
+  EXPECT_EQ(trades[0].counterparty, "client2");
+  EXPECT_EQ(book.order_count(), 1);
+}
+
+TEST_F(OrderbookTests, ModifyOrderInvalidLeavesOrder) {
+  auto now = std::chrono::system_clock::now();
+
+  Order order("client1", Price("100.0000"), 1, 100, Side::BUY, now);
+  book.place_order(order, trades);
+
+  EXPECT_EQ(book.modify_order(1, Price("100.0000"), 0), OrderResult::INVALID_ORDER);
+  EXPECT_EQ(book.get_volume_at_price(Price("100.0"), Side::BUY), 100);
+  EXPECT_EQ(book.order_count(), 1);
+}
+
 TEST_F(OrderbookTests, ModifyOrderNonExistent) {
   auto result = book.modify_order(999, Price("100.0000"), 50);
   EXPECT_EQ(result, OrderResult::ORDER_NOT_FOUND);
@@ -263,4 +363,233 @@ TEST_F(OrderbookTests, MarketDataDepth) {
   EXPECT_EQ(asks[0].order_count, 1);
   EXPECT_EQ(asks[1].price.to_double(), 102.0);
   EXPECT_EQ(asks[2].price.to_double(), 103.0);
-}
\ No newline at end of file
+}
+
+TEST_F(OrderbookTests, ImmediateOrCancelDoesNotRest) {
+  auto now = std::chrono::system_clock::now();
+
+  book.place_order(Order("seller", Price("100.0000"), 1, 30, Side::SELL, now), trades);
+
+  Order ioc("buyer", Price("100.0000"), 2, 50, Side::BUY, now);
+  ioc.set_time_in_force(TimeInForce::IOC);
+  auto result = book.place_order(ioc, trades);
+
+  EXPECT_EQ(result, OrderResult::PARTIAL_FILL);
+  ASSERT_EQ(trades.size(), 1);
+  EXPECT_EQ(trades[0].volume, 30);
+  EXPECT_EQ(book.order_count(), 0);
+  EXPECT_EQ(book.price_level_count(), 0);
+
+  // Nothing to trade against - cancelled outright
+  Order ioc2("buyer", Price("100.0000"), 3, 50, Side::BUY, now);
+  ioc2.set_time_in_force(TimeInForce::IOC);
+  EXPECT_EQ(book.place_order(ioc2, trades), OrderResult::CANCELLED);
+  EXPECT_EQ(book.order_count(), 0);
+}
+
+TEST_F(OrderbookTests, FillOrKillRejectedWithoutTouchingBook) {
+  auto now = std::chrono::system_clock::now();
+
+  book.place_order(Order("s1", Price("100.0000"), 1, 30, Side::SELL, now), trades);
+  book.place_order(Order("s2", Price("101.0000"), 2, 30, Side::SELL, now), trades);
+  book.place_order(Order("s3", Price("102.0000"), 3, 30, Side::SELL, now), trades);
+  uint64_t checksum = book.checksum();
+
+  // Only 60 available at or below 101
+  Order fok("buyer", Price("101.0000"), 4, 70, Side::BUY, now);
+  fok.set_time_in_force(TimeInForce::FOK);
+  EXPECT_EQ(book.place_order(fok, trades), OrderResult::CANCELLED);
+  EXPECT_TRUE(trades.empty());
+  EXPECT_EQ(book.order_count(), 3);
+  EXPECT_EQ(book.checksum(), checksum);
+}
+
+TEST_F(OrderbookTests, FillOrKillExecutesAcrossLevels) {
+  auto now = std::chrono::system_clock::now();
+
+  book.place_order(Order("b1", Price("100.0000"), 1, 30, Side::BUY, now), trades);
+  book.place_order(Order("b2", Price("99.0000"), 2, 30, Side::BUY, now), trades);
+
+  Order fok("seller", Price("99.0000"), 3, 60, Side::SELL, now);
+  fok.set_time_in_force(TimeInForce::FOK);
+  EXPECT_EQ(book.place_order(fok, trades), OrderResult::COMPLETE_FILL);
+  ASSERT_EQ(trades.size(), 2);
+  EXPECT_EQ(trades[0].price.to_double(), 100.0);
+  EXPECT_EQ(trades[1].price.to_double(), 99.0);
+  EXPECT_EQ(book.order_count(), 0);
+}
+
+TEST_F(OrderbookTests, MassCancelRemovesOnlyThatParticipant) {
+  auto now = std::chrono::system_clock::now();
+  for (int i = 1; i <= 6; ++i) {
+    Order order("client", Price::fromRaw((100 - i) * 10000), i, 10, Side::BUY, now);
+    order.set_participant_id(i % 2 == 0 ? 4 : 5);
+    book.place_order(order, trades);
+  }
+  Order stop("client", Price(), 7, 10, Side::SELL, now);
+  stop.set_order_type(OrderType::STOP);
+  stop.set_stop_price(Price("90.0000"));
+  stop.set_participant_id(4);
+  book.place_order(stop, trades);
+
+  EXPECT_EQ(book.mass_cancel(4), 4u);
+  EXPECT_EQ(book.order_count(), 3);
+  EXPECT_EQ(book.price_level_count(), 3);
+  EXPECT_EQ(book.cancel_order(2), OrderResult::ORDER_NOT_FOUND);
+  EXPECT_EQ(book.cancel_order(7), OrderResult::ORDER_NOT_FOUND);
+  EXPECT_EQ(book.mass_cancel(4), 0u);
+}
+
+TEST_F(OrderbookTests, MassCancelHonoursSideAndPriceFilter) {
+  auto now = std::chrono::system_clock::now();
+  for (int i = 1; i <= 4; ++i) {
+    Order bid("client", Price::fromRaw((100 - i) * 10000), i, 10, Side::BUY, now);
+    bid.set_participant_id(3);
+    book.place_order(bid, trades);
+    Order ask("client", Price::fromRaw((100 + i) * 10000), 10 + i, 10, Side::SELL, now);
+    ask.set_participant_id(3);
+    book.place_order(ask, trades);
+  }
+
+  MassCancelFilter filter;
+  filter.include_sells = false;
+  filter.min_price = Price("97.0000");
+  EXPECT_EQ(book.mass_cancel(3, filter), 3u);
+  EXPECT_EQ(book.get_best_bid().to_double(), 96.0);
+  EXPECT_EQ(book.get_best_ask().to_double(), 101.0);
+
+  // Filled and individually cancelled orders have already left the list
+  book.place_order(Order("taker", Price("101.0000"), 20, 10, Side::BUY, now), trades);
+  book.cancel_order(12);
+  EXPECT_EQ(book.mass_cancel(3), 3u);
+  EXPECT_EQ(book.order_count(), 0);
+  EXPECT_EQ(book.checksum(), 0u);
+}
+
+TEST_F(OrderbookTests, TrimMemoryFollowsLiveBook) {
+  auto now = std::chrono::system_clock::now();
+  for (int id = 1; id <= 5000; ++id) {
+    book.place_order(Order("client", Price::fromRaw((9000 + id % 50) * 100), id, 10, Side::BUY, now), trades);
+  }
+  auto peak = book.memory_stats();
+  EXPECT_EQ(peak.orders.used, 5000u);
+  EXPECT_EQ(peak.orders.blocks, 5u);
+
+  // Nothing to release while the book is full
+  EXPECT_EQ(book.compaction_point(), 0u);
+
+  for (int id = 1; id <= 4900; ++id) {
+    book.cancel_order(id);
+  }
+  uint64_t checksum = book.checksum();
+  EXPECT_EQ(book.compaction_point(0.25, 1), 3u);
+
+  auto trimmed = book.memory_stats();
+  EXPECT_EQ(trimmed.orders.blocks, 2u);
+  EXPECT_EQ(trimmed.orders.used, 100u);
+  EXPECT_EQ(trimmed.orders.high_water, 5000u);
+  EXPECT_EQ(trimmed.orders.deallocations, 4900u);
+  EXPECT_EQ(book.checksum(), checksum);
+
+  // Survivors still trade
+  book.place_order(Order("taker", Price("0.01"), 6000, 1000, Side::SELL, now), trades);
+  EXPECT_EQ(book.order_count(), 0u);
+  EXPECT_EQ(trades.size(), 100u);
+}
+
+TEST_F(OrderbookTests, MoveKeepsLevelsAndIndexes) {
+  auto now = std::chrono::system_clock::now();
+  for (int i = 1; i <= 20; ++i) {
+    Side side = i % 2 ? Side::BUY : Side::SELL;
+    Order order("client", Price::fromRaw((side == Side::BUY ? 99 - i % 5 : 101 + i % 5) * 10000), i, 10, side, now);
+    order.set_participant_id(i % 3 + 1);
+    book.place_order(order, trades);
+  }
+  Order gtt("expiring", Price("95.0000"), 21, 10, Side::BUY, now);
+  gtt.set_time_in_force(TimeInForce::GTT);
+  gtt.set_expire_time(now + std::chrono::seconds(5));
+  book.place_order(gtt, trades);
+  Order stop("client", Price(), 22, 10, Side::SELL, now);
+  stop.set_order_type(OrderType::STOP);
+  stop.set_stop_price(Price("90.0000"));
+  book.place_order(stop, trades);
+  book.set_self_trade_prevention(SelfTradePrevention::CANCEL_NEWEST);
+  TradeAggregator aggregator;
+  book.set_trade_aggregator(&aggregator);
+
+  uint64_t checksum = book.checksum();
+  BookStats stats = book.stats();
+  int64_t depth = book.cumulative_volume(Side::BUY, Price("96.0000"));
+
+  Orderbook moved(std::move(book));
+  EXPECT_EQ(moved.checksum(), checksum);
+  EXPECT_EQ(moved.stats().bids.levels, stats.bids.levels);
+  EXPECT_EQ(moved.stats().asks.displayed_volume, stats.asks.displayed_volume);
+  EXPECT_EQ(moved.order_count(), 22);
+  EXPECT_EQ(moved.cumulative_volume(Side::BUY, Price("96.0000")), depth);
+  EXPECT_EQ(moved.get_bid_levels(10).size(), 5u);
+
+  // The moved-from book is empty, still works and no longer reports trades
+  EXPECT_EQ(book.order_count(), 0);
+  EXPECT_EQ(book.price_level_count(), 0u);
+  EXPECT_EQ(book.checksum(), 0u);
+  EXPECT_EQ(book.stats().trades, 0u);
+  EXPECT_FALSE(book.has_order(1));
+  EXPECT_EQ(book.place_order(Order("fresh", Price("100.0000"), 1, 5, Side::BUY, now), trades), OrderResult::SUCCESS);
+  EXPECT_EQ(book.get_best_bid(), Price("100.0000"));
+  trades.clear();
+  EXPECT_EQ(book.place_order(Order("fresh", Price("100.0000"), 2, 5, Side::SELL, now), trades), OrderResult::COMPLETE_FILL);
+  EXPECT_EQ(trades.size(), 1u);
+  EXPECT_EQ(aggregator.session_trade_count(), 0u);
+
+  // Every index moved with the orders
+  EXPECT_EQ(moved.cancel_order(2), OrderResult::SUCCESS);
+  EXPECT_EQ(moved.mass_cancel(1), 6u);
+  EXPECT_EQ(moved.advance_time(now + std::chrono::seconds(6)), 1u);
+  Order self("client", Price("101.0000"), 30, 10, Side::BUY, now);
+  self.set_participant_id(2);
+  trades.clear();
+  moved.place_order(self, trades);
+  EXPECT_TRUE(trades.empty());
+  trades.clear();
+  moved.place_order(Order("taker", Price("94.0000"), 31, 1000, Side::SELL, now), trades);
+  EXPECT_EQ(moved.get_bid_levels(10).size(), 0u);
+  EXPECT_EQ(moved.stats().bids.orders, 0);
+  EXPECT_GT(aggregator.session_trade_count(), 0u);
+}
+
+TEST_F(OrderbookTests, SwapInBookBuiltOnAnotherThread) {
+  auto now = std::chrono::system_clock::now();
+  book.place_order(Order("old", Price("50.0000"), 1, 10, Side::BUY, now), trades);
+
+  Orderbook rebuilt;
+  std::thread builder([&] {
+    std::vector<TradeInfo> fills;
+    for (int i = 1; i <= 2000; ++i) {
+      Side side = i % 2 ? Side::BUY : Side::SELL;
+      rebuilt.place_order(Order("snap", Price::fromRaw((side == Side::BUY ? 900 + i % 90 : 1001 + i % 90) * 1000), i, 5, side, now), fills);
+    }
+  });
+  builder.join();
+  uint64_t checksum = rebuilt.checksum();
+
+  book.swap(rebuilt);
+  EXPECT_EQ(book.checksum(), checksum);
+  EXPECT_EQ(book.order_count(), 2000);
+  EXPECT_EQ(rebuilt.order_count(), 1);
+  EXPECT_EQ(rebuilt.get_best_bid(), Price("50.0000"));
+
+  // Both keep matching against their own pools
+  trades.clear();
+  book.place_order(Order("taker", Price("100.1000"), 5000, 5, Side::BUY, now), trades);
+  EXPECT_EQ(trades.size(), 1u);
+  EXPECT_EQ(rebuilt.cancel_order(1), OrderResult::SUCCESS);
+  EXPECT_EQ(rebuilt.price_level_count(), 0u);
+
+  // Move assignment releases what was there
+  rebuilt = std::move(book);
+  EXPECT_EQ(rebuilt.order_count(), 1999);
+  EXPECT_NE(rebuilt.checksum(), checksum);
+  EXPECT_EQ(rebuilt.memory_stats().orders.used, 1999u);
+  EXPECT_EQ(book.order_count(), 0);
+}
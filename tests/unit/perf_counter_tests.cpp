@@ -0,0 +1,52 @@
+#include <gtest/gtest.h>
+#include "orderbook/BookProfiler.h"
+#include "orderbook/Orderbook.h"
+
+using namespace trading;
+
+TEST(PerfCounterTests, GroupReadsOrDegradesToZeros) {
+  metrics::PerfCounterGroup group;
+  metrics::PerfSample before, after;
+  group.read(before);
+
+  volatile uint64_t sink = 0;
+  for (int i = 0; i < 100000; ++i) {
+    sink = sink + i;
+  }
+  group.read(after);
+
+  if (group.available()) {
+    EXPECT_GT(after.values[static_cast<size_t>(metrics::PerfEvent::CYCLES)],
+              before.values[static_cast<size_t>(metrics::PerfEvent::CYCLES)]);
+  } else {
+    for (uint64_t value : after.values) {
+      EXPECT_EQ(value, 0u);
+    }
+  }
+}
+
+TEST(PerfCounterTests, ProfilerCountsCallsPerOperation) {
+  BookProfiler profiler;
+  Orderbook book;
+  std::vector<TradeInfo> trades;
+  auto now = std::chrono::system_clock::now();
+
+  for (int i = 1; i <= 50; ++i) {
+    profiler.measure(BookOperation::PLACE, [&] {
+      book.place_order(Order("c", Price("100.0000"), i, 10, Side::BUY, now), trades);
+    });
+  }
+  profiler.measure(BookOperation::CANCEL, [&] { book.cancel_order(1); });
+
+  EXPECT_EQ(book.order_count(), 49u);
+  EXPECT_EQ(profiler.totals(BookOperation::PLACE).calls, 50u);
+  EXPECT_EQ(profiler.totals(BookOperation::CANCEL).calls, 1u);
+  EXPECT_EQ(profiler.totals(BookOperation::MODIFY).calls, 0u);
+
+  std::ostringstream out;
+  profiler.print(out);
+  EXPECT_FALSE(out.str().empty());
+
+  profiler.reset();
+  EXPECT_EQ(profiler.totals(BookOperation::PLACE).calls, 0u);
+}
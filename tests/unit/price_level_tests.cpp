@@ -7,7 +7,7 @@ using namespace trading;
 class PriceLevelTests : public ::testing::Test {
 protected:
   void SetUp() override {
-    level = new PriceLevel(Price("100.0000"));
+    level = new PriceLevel(Price("100.0000"), 10000);
   }
   
   void TearDown() override {
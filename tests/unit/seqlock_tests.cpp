@@ -0,0 +1,46 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include "common/SeqLock.h"
+
+using namespace trading::concurrency;
+
+namespace {
+struct Snapshot {
+  uint64_t a;
+  uint64_t b[7];
+};
+}
+
+TEST(SeqLockTests, ReadersNeverSeeTornValues) {
+  SeqLock<Snapshot> lock;
+  std::atomic<bool> done{false};
+  constexpr uint64_t WRITES = 200000;
+
+  std::thread writer([&] {
+    Snapshot s;
+    for (uint64_t i = 1; i <= WRITES; ++i) {
+      s.a = i;
+      for (auto& v : s.b) v = i * 3;
+      lock.store(s);
+    }
+    done.store(true);
+  });
+
+  uint64_t last = 0;
+  uint64_t reads = 0;
+  while (!done.load()) {
+    Snapshot s = lock.load();
+    for (auto v : s.b) {
+      ASSERT_EQ(v, s.a * 3);
+    }
+    ASSERT_GE(s.a, last);
+    last = s.a;
+    reads++;
+  }
+  writer.join();
+
+  EXPECT_GT(reads, 0u);
+  EXPECT_EQ(lock.version(), WRITES);
+  EXPECT_EQ(lock.load().a, WRITES);
+}
@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include "orderbook/Orderbook.h"
+#include "orderbook/TickTable.h"
+
+using namespace trading;
+
+// Prices are usable in constant expressions
+static_assert(Price::fromRaw(150) + Price::fromRaw(50) == Price::fromRaw(200));
+static_assert(Price(1.5).raw_value() == 15000);
+static_assert(Price(1.13).raw_value() == 11300 && Price(-1.13).raw_value() == -11300);
+static_assert(BasicPrice<100>::DECIMALS == 2);
+
+TEST(FixedPointTests, ScaleControlsParsingAndFormatting) {
+  using Cents = BasicPrice<100>;
+  EXPECT_EQ(Cents("12.345").raw_value(), 1234);
+  EXPECT_EQ(Cents("12.3").to_string(), "12.30");
+  EXPECT_EQ(BasicPrice<1>("7").to_string(), "7");
+  EXPECT_EQ(Price("-0.5").to_string(), "-0.5000");
+  EXPECT_THROW(Price::fromRaw(INT64_MAX) + Price::fromRaw(1), std::overflow_error);
+}
+
+TEST(TickTableTests, IndexesAcrossBands) {
+  TickTable table({{Price(), Price("0.0001")}, {Price("1.00"), Price("0.01")}, {Price("100"), Price("0.05")}});
+
+  EXPECT_EQ(table.min_tick(), Price("0.0001"));
+  EXPECT_EQ(table.tick_at(Price("50")), Price("0.01"));
+  EXPECT_TRUE(table.is_valid(Price("0.9999")));
+  EXPECT_TRUE(table.is_valid(Price("1.01")));
+  EXPECT_FALSE(table.is_valid(Price("1.0001")));
+  EXPECT_FALSE(table.is_valid(Price("100.01")));
+  EXPECT_FALSE(table.is_valid(Price()));
+
+  // 10000 ticks below 1.00, then 9900 of 0.01 up to 100
+  EXPECT_EQ(table.to_index(Price("1.00")), 10000);
+  EXPECT_EQ(table.to_index(Price("100")), 19900);
+  EXPECT_EQ(table.to_index(Price("1.0150")), 10001);
+  EXPECT_EQ(table.from_index(19901), Price("100.05"));
+  EXPECT_EQ(table.offset(Price("0.9999"), 2), Price("1.01"));
+  EXPECT_EQ(table.offset(Price("100.05"), -2), Price("99.99"));
+}
+
+TEST(TickTableTests, RejectsMalformedSchedules) {
+  EXPECT_THROW(TickTable(std::vector<TickTable::Band>{}), std::invalid_argument);
+  EXPECT_THROW(TickTable({{Price("1"), Price("0.01")}}), std::invalid_argument);
+  EXPECT_THROW(TickTable({{Price(), Price()}}), std::invalid_argument);
+  EXPECT_THROW(TickTable({{Price(), Price("0.03")}, {Price("1.00"), Price("0.05")}}), std::invalid_argument);
+  EXPECT_THROW(TickTable({{Price(), Price("0.01")}, {Price(), Price("0.05")}}), std::invalid_argument);
+}
+
+TEST(TickTableTests, BookRejectsOffGridPrices) {
+  Orderbook book(TickTable({{Price(), Price("0.01")}, {Price("100"), Price("0.05")}}));
+  std::vector<TradeInfo> trades;
+  auto now = std::chrono::system_clock::now();
+
+  EXPECT_EQ(book.place_order(Order("a", Price("100.02"), 1, 10, Side::SELL, now), trades), OrderResult::INVALID_ORDER);
+  EXPECT_EQ(book.place_order(Order("a", Price("100.05"), 1, 10, Side::SELL, now), trades), OrderResult::SUCCESS);
+  EXPECT_EQ(book.place_order(Order("b", Price("99.99"), 2, 10, Side::BUY, now), trades), OrderResult::SUCCESS);
+  EXPECT_EQ(book.modify_order(2, Price("99.995"), 10), OrderResult::INVALID_ORDER);
+  EXPECT_EQ(book.get_tick_size(), Price("0.01"));
+
+  // Two ticks through the best bid crosses the band edge
+  book.place_order(Order("c", Price("100.10"), 3, 5, Side::SELL, now), trades);
+  EXPECT_EQ(book.volume_within_ticks(Side::SELL, 1), 15);
+  EXPECT_EQ(book.volume_within_ticks(Side::BUY, 2), 10);
+}
+
+TEST(TickTableTests, BookQueriesRoundToTheGrid) {
+  Orderbook book(TickTable({{Price(), Price("0.01")}, {Price("100"), Price("0.05")}}));
+  std::vector<TradeInfo> trades;
+  auto now = std::chrono::system_clock::now();
+
+  book.place_order(Order("a", Price("100.05"), 1, 10, Side::BUY, now), trades);
+  book.place_order(Order("a", Price("99.99"), 2, 20, Side::BUY, now), trades);
+  book.place_order(Order("b", Price("100.10"), 3, 5, Side::SELL, now), trades);
+  book.place_order(Order("b", Price("100.20"), 4, 7, Side::SELL, now), trades);
+
+  EXPECT_EQ(book.get_volume_at_price(Price("100.05"), Side::BUY), 10);
+  EXPECT_EQ(book.get_volume_at_price(Price("100.06"), Side::BUY), 0);
+
+  // Bids round up to the next grid price, asks down
+  EXPECT_EQ(book.cumulative_volume(Side::BUY, Price("100.01")), 10);
+  EXPECT_EQ(book.cumulative_volume(Side::BUY, Price("99.985")), 30);
+  EXPECT_EQ(book.cumulative_volume(Side::SELL, Price("100.19")), 5);
+  EXPECT_EQ(book.cumulative_volume(Side::SELL, Price("100.20")), 12);
+
+  EXPECT_EQ(book.price_for_volume(Side::BUY, 11), Price("99.99"));
+  EXPECT_EQ(book.price_for_volume(Side::SELL, 6), Price("100.20"));
+  EXPECT_EQ(book.price_for_volume(Side::SELL, 13), Price());
+
+  // A buy stop below the band edge fires on a trade above it
+  Order stop("c", Price(), 5, 3, Side::BUY, now);
+  stop.set_order_type(OrderType::STOP);
+  stop.set_stop_price(Price("99.99"));
+  EXPECT_EQ(book.place_order(stop, trades), OrderResult::SUCCESS);
+  EXPECT_EQ(book.place_order(Order("d", Price("100.05"), 6, 10, Side::SELL, now), trades), OrderResult::COMPLETE_FILL);
+  EXPECT_EQ(book.get_volume_at_price(Price("100.10"), Side::SELL), 2);
+}
+
+TEST(TickTableTests, DoublePricesLandOnTheCentGrid) {
+  Orderbook book;
+  std::vector<TradeInfo> trades;
+  auto now = std::chrono::system_clock::now();
+
+  // Every two-decimal price up to 10.00, built from a double, is on the default grid
+  int id = 1;
+  for (int cents = 1; cents <= 1000; ++cents) {
+    double price = cents / 100.0;
+    ASSERT_EQ(book.place_order(Order("c", price, id, 10, Side::BUY, now), trades), OrderResult::SUCCESS) << price;
+    ASSERT_EQ(book.modify_order(id, price + 0.01, 5), OrderResult::SUCCESS) << price;
+    ++id;
+  }
+  EXPECT_EQ(book.get_volume_at_price(1.13, Side::BUY), 5);
+  EXPECT_EQ(book.get_volume_at_price(2.01, Side::BUY), 5);
+}
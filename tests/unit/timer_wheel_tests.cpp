@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+#include <random>
+#include "orderbook/TimerWheel.h"
+
+using namespace trading;
+
+class TimerWheelTests : public ::testing::Test {
+protected:
+  TimerWheel wheel;
+  std::vector<Order*> expired;
+};
+
+TEST_F(TimerWheelTests, FiresAtExpiryAcrossLevels) {
+  std::vector<Order> orders(4);
+  uint64_t expiries[] = {5, 300, 70000, 20000000};
+  for (int i = 0; i < 4; ++i) {
+    orders[i].set_order_id(i);
+    wheel.schedule(&orders[i], expiries[i]);
+  }
+
+  for (int i = 0; i < 4; ++i) {
+    wheel.advance(expiries[i] - 1, expired);
+    EXPECT_EQ(expired.size(), static_cast<size_t>(i));
+    wheel.advance(expiries[i], expired);
+    ASSERT_EQ(expired.size(), static_cast<size_t>(i + 1));
+    EXPECT_EQ(expired.back()->get_order_id(), i);
+  }
+  EXPECT_EQ(wheel.size(), 0u);
+}
+
+TEST_F(TimerWheelTests, StartsAtAnEpochTick) {
+  // 2025-10-09 in epoch milliseconds
+  const uint64_t start = 1760000000000ULL;
+  wheel.start(start);
+  EXPECT_EQ(wheel.current_tick(), start);
+
+  std::vector<Order> orders(4);
+  uint64_t offsets[] = {5, 300, 70000, 20000000};
+  for (int i = 0; i < 4; ++i) {
+    orders[i].set_order_id(i);
+    wheel.schedule(&orders[i], start + offsets[i]);
+  }
+
+  // A scheduled wheel keeps its place
+  wheel.start(0);
+  EXPECT_EQ(wheel.current_tick(), start);
+
+  for (int i = 0; i < 4; ++i) {
+    wheel.advance(start + offsets[i] - 1, expired);
+    EXPECT_EQ(expired.size(), static_cast<size_t>(i));
+    wheel.advance(start + offsets[i], expired);
+    ASSERT_EQ(expired.size(), static_cast<size_t>(i + 1));
+    EXPECT_EQ(expired.back()->get_order_id(), i);
+  }
+}
+
+TEST_F(TimerWheelTests, CancelledTimersNeverFire) {
+  std::vector<Order> orders(3);
+  for (int i = 0; i < 3; ++i) {
+    wheel.schedule(&orders[i], 1000);
+  }
+
+  wheel.cancel(&orders[1]);
+  wheel.cancel(&orders[1]);
+  EXPECT_FALSE(wheel.is_scheduled(&orders[1]));
+
+  wheel.advance(1000, expired);
+  EXPECT_EQ(expired.size(), 2u);
+  EXPECT_EQ(wheel.size(), 0u);
+}
+
+TEST_F(TimerWheelTests, RandomExpiriesFireInTickOrder) {
+  std::mt19937 gen(3);
+  std::uniform_int_distribution<uint64_t> expiry_dist(1, 1ULL << 33);
+  std::vector<Order> orders(5000);
+  for (auto& order : orders) {
+    wheel.schedule(&order, expiry_dist(gen));
+  }
+
+  uint64_t tick = 0;
+  size_t fired = 0;
+  while (wheel.size() > 0) {
+    tick += 1ULL << 20;
+    wheel.advance(tick, expired);
+    for (; fired < expired.size(); ++fired) {
+      EXPECT_LE(expired[fired]->timer_expiry, tick);
+      EXPECT_GT(expired[fired]->timer_expiry, tick - (1ULL << 20));
+    }
+  }
+  EXPECT_EQ(expired.size(), orders.size());
+}
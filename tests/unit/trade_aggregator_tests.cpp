@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+#include "orderbook/TradeAggregator.h"
+#include "orderbook/Orderbook.h"
+
+using namespace trading;
+
+namespace {
+constexpr uint64_t SECOND = 1'000'000'000ULL;
+}
+
+TEST(TradeAggregatorTests, TimeBarsAlignAndPublishOnRollover) {
+  TradeAggregatorConfig config;
+  config.time_bar_ns = SECOND;
+  TradeAggregator aggregator(config);
+
+  aggregator.on_fill(Price("100.0000"), 10, 5 * SECOND + 100);
+  aggregator.on_fill(Price("101.0000"), 30, 5 * SECOND + 200);
+  aggregator.on_fill(Price("99.0000"), 10, 5 * SECOND + 300);
+
+  Bar bar;
+  EXPECT_FALSE(aggregator.pop_bar(bar));
+
+  // Next bucket (with an empty one skipped) closes the first
+  aggregator.on_fill(Price("102.0000"), 5, 7 * SECOND);
+  ASSERT_TRUE(aggregator.pop_bar(bar));
+  EXPECT_EQ(bar.type, BarType::TIME);
+  EXPECT_EQ(bar.start_ns, 5 * SECOND);
+  EXPECT_EQ(bar.end_ns, 6 * SECOND);
+  EXPECT_EQ(bar.open, Price("100.0000").raw_value());
+  EXPECT_EQ(bar.high, Price("101.0000").raw_value());
+  EXPECT_EQ(bar.low, Price("99.0000").raw_value());
+  EXPECT_EQ(bar.close, Price("99.0000").raw_value());
+  EXPECT_EQ(bar.volume, 50);
+  EXPECT_EQ(bar.trade_count, 3u);
+  // (100*10 + 101*30 + 99*10) / 50
+  EXPECT_EQ(bar.vwap(), Price("100.4000"));
+  EXPECT_FALSE(aggregator.pop_bar(bar));
+
+  aggregator.flush();
+  ASSERT_TRUE(aggregator.pop_bar(bar));
+  EXPECT_EQ(bar.start_ns, 7 * SECOND);
+  EXPECT_EQ(bar.volume, 5);
+
+  EXPECT_EQ(aggregator.session_volume(), 55);
+  EXPECT_EQ(aggregator.session_trade_count(), 4u);
+}
+
+TEST(TradeAggregatorTests, VolumeBarsSplitLargeFills) {
+  TradeAggregatorConfig config;
+  config.time_bar_ns = 0;
+  config.volume_bar_size = 100;
+  TradeAggregator aggregator(config);
+
+  aggregator.on_fill(Price("50.0000"), 60, 1);
+  aggregator.on_fill(Price("51.0000"), 150, 2);   // completes one bar, fills another, leaves 10
+
+  Bar bar;
+  ASSERT_TRUE(aggregator.pop_bar(bar));
+  EXPECT_EQ(bar.type, BarType::VOLUME);
+  EXPECT_EQ(bar.volume, 100);
+  EXPECT_EQ(bar.open, Price("50.0000").raw_value());
+  EXPECT_EQ(bar.close, Price("51.0000").raw_value());
+  EXPECT_EQ(bar.vwap(), Price("50.4000"));
+
+  ASSERT_TRUE(aggregator.pop_bar(bar));
+  EXPECT_EQ(bar.volume, 100);
+  EXPECT_EQ(bar.vwap(), Price("51.0000"));
+  EXPECT_FALSE(aggregator.pop_bar(bar));
+  EXPECT_EQ(aggregator.current_volume_bar().volume, 10);
+}
+
+TEST(TradeAggregatorTests, BookFeedsEveryFill) {
+  TradeAggregatorConfig config;
+  config.volume_bar_size = 100;
+  TradeAggregator aggregator(config);
+
+  Orderbook book;
+  book.set_trade_aggregator(&aggregator);
+  std::vector<TradeInfo> trades;
+  auto now = std::chrono::system_clock::now();
+
+  book.place_order(Order("s1", Price("100.0000"), 1, 40, Side::SELL, now), trades);
+  book.place_order(Order("s2", Price("100.5000"), 2, 60, Side::SELL, now), trades);
+  book.place_order(Order("s3", Price("101.0000"), 3, 50, Side::SELL, now), trades);
+
+  // Sweep through the level-fill path and the per-order path
+  std::vector<LevelFillInfo> level_fills;
+  book.place_order(Order("b1", Price("100.5000"), 4, 100, Side::BUY, now), trades, level_fills);
+  book.place_order(Order("b2", Price("101.0000"), 5, 20, Side::BUY, now), trades);
+
+  EXPECT_EQ(aggregator.session_volume(), 120);
+  EXPECT_EQ(aggregator.session_trade_count(), 3u);
+  // (100*40 + 100.5*60 + 101*20) / 120, truncated to the raw tick
+  EXPECT_EQ(aggregator.vwap(), Price("100.4166"));
+
+  Bar bar;
+  ASSERT_TRUE(aggregator.pop_bar(bar));
+  EXPECT_EQ(bar.volume, 100);
+  EXPECT_EQ(bar.high, Price("100.5000").raw_value());
+}
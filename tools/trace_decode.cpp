@@ -0,0 +1,34 @@
+// Prints a flight-recorder dump (FlightRecorder::dump_all or the crash
+// handler) as one timeline across threads.
+//
+//   trace_decode <dump> [last N records]
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include "../include/utils/FlightRecorder.h"
+
+using namespace trading;
+
+int main(int argc, char** argv) {
+	if (argc < 2) {
+		std::cerr << "usage: " << argv[0] << " <dump> [last N records]\n";
+		return 2;
+	}
+
+	try {
+		trace::DecodedTrace decoded = trace::decode_trace(argv[1]);
+		if (argc > 2) {
+			size_t keep = std::strtoull(argv[2], nullptr, 10);
+			if (keep < decoded.records.size()) {
+				decoded.records_lost += decoded.records.size() - keep;
+				decoded.records.erase(decoded.records.begin(), decoded.records.end() - static_cast<std::ptrdiff_t>(keep));
+			}
+		}
+		std::cout << decoded.records.size() << " records, " << decoded.ticks_per_ns << " ticks/ns\n";
+		trace::print_timeline(decoded, std::cout);
+	} catch (const std::exception& e) {
+		std::cerr << e.what() << "\n";
+		return 1;
+	}
+	return 0;
+}